@@ -180,9 +180,26 @@ namespace mstd {
 		return fn;
 	}
 
+	// 单字节整数的指针区间用 memchr 查找
+	template<class IptIter, class Tp>
+	constexpr bool _Find_memchr_is_safe = is_pointer_v<IptIter> && is_integral_v<Tp> &&
+		_Is_character_v<_Iter_value_t<IptIter>>;
+
 	template<class IptIter, class Tp>
 	inline IptIter find(IptIter first, IptIter last, const Tp& val)
 	{
+		if constexpr (_Is_segmented_iter_v<IptIter>) {	// 逐块在指针区间中查找
+			const auto found = _Visit_segments(first, static_cast<size_t>(last - first), [&val](auto ptr, const size_t num) {
+				return static_cast<size_t>(mstd::find(ptr, ptr + num, val) - ptr);
+			});
+			return first + static_cast<_Iter_difference_t<IptIter>>(found);
+		}
+		else if constexpr (_Find_memchr_is_safe<IptIter, Tp>) {
+			using Elem = remove_cv_t<_Iter_value_t<IptIter>>;
+			if (static_cast<Tp>(static_cast<Elem>(val)) != val) { return last; }	// 超出元素类型的范围
+			const void* result = std::memchr(first, static_cast<unsigned char>(static_cast<Elem>(val)), static_cast<size_t>(last - first));
+			return result ? first + (static_cast<const unsigned char*>(result) - reinterpret_cast<const unsigned char*>(first)) : last;
+		}
 		while (first != last) {
 			if (*first == val) return first;
 			++first;
@@ -492,6 +509,81 @@ namespace mstd {
 		swap(*left, *right);
 	}
 
+	// reverse/rotate 只通过 mstd::move 和 mstd::swap 移动元素，不按 ADL 查找 swap，
+	// 元素类型同时关联 std 和 mstd 时不会在 std::swap 与 mstd::swap 之间产生歧义
+	template <class BidIter>
+	constexpr void reverse(BidIter first, BidIter last)
+	{
+		for (; first != last && first != --last; ++first) {
+			mstd::swap(*first, *last);
+		}
+	}
+
+	// 使 mid 成为第一个元素，返回原来的 first 元素的新位置
+	template <class FwdIter>
+	constexpr FwdIter rotate(FwdIter first, FwdIter mid, FwdIter last)
+	{
+		if (first == mid) { return last; }
+		if (mid == last) { return first; }
+		using category = typename std::iterator_traits<FwdIter>::iterator_category;
+		if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>) {
+			using diff = typename std::iterator_traits<FwdIter>::difference_type;
+			const diff total = last - first;
+			const diff shift = mid - first;
+			const FwdIter result = first + (total - shift);
+			// 只旋转一个元素时(容器中间插入一个元素)用一个临时对象整体平移
+			if (1 == shift) {
+				auto temp = mstd::move(*first);
+				for (FwdIter iter = first; iter != last - 1; ++iter) { *iter = mstd::move(*(iter + 1)); }
+				*(last - 1) = mstd::move(temp);
+				return result;
+			}
+			if (1 == total - shift) {
+				auto temp = mstd::move(*(last - 1));
+				for (FwdIter iter = last - 1; iter != first; --iter) { *iter = mstd::move(*(iter - 1)); }
+				*first = mstd::move(temp);
+				return result;
+			}
+			// 共 gcd(total, shift) 个置换环，每个元素只移动一次
+			diff cycles = total;
+			for (diff rem = shift; rem != 0; ) {
+				const diff next = cycles % rem;
+				cycles = rem;
+				rem = next;
+			}
+			for (diff start = 0; start != cycles; ++start) {
+				auto temp = mstd::move(first[start]);
+				diff hole = start;
+				for (;;) {
+					diff next = hole + shift;
+					if (next >= total) { next -= total; }
+					if (next == start) { break; }
+					first[hole] = mstd::move(first[next]);
+					hole = next;
+				}
+				first[hole] = mstd::move(temp);
+			}
+			return result;
+		}
+		else {
+			FwdIter next = mid;
+			do {
+				mstd::swap(*first, *next);
+				++first; ++next;
+				if (first == mid) { mid = next; }
+			} while (next != last);
+			const FwdIter result = first;
+			next = mid;
+			while (next != last) {
+				mstd::swap(*first, *next);
+				++first; ++next;
+				if (first == mid) { mid = next; }
+				else if (next == last) { next = mid; }
+			}
+			return result;
+		}
+	}
+
 	template <class IptIter, class OptIter, class UnaryPred>
 	inline OptIter transform(IptIter first1, IptIter last1, OptIter result, UnaryPred pred)
 	{
@@ -1,14 +1,148 @@
 #pragma once
 
 #include <cstdlib>
+#include <cstddef>
 #include <cstring>
+#include <cassert>
 #include <new>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+#include <vector>
+#include <ostream>
+#include <type_traits>
+
+#if defined(__GLIBC__) || defined(_WIN32)
+#include <malloc.h>			// malloc_usable_size(); _msize();
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>	// malloc_size();
+#endif
 
 namespace mstd {
 
 	const size_t PoolSize = 20;
 
-	// һ
+	// 分配器统计，定义 _MSTD_ALLOC_STATS 为1开启，关闭时计数器全部为空操作
+#ifndef _MSTD_ALLOC_STATS
+#define _MSTD_ALLOC_STATS 0
+#endif
+
+	struct _Stat_counter {
+#if _MSTD_ALLOC_STATS
+		std::atomic<size_t> value_{ 0 };
+
+		void add(size_t n = 1) noexcept { value_.fetch_add(n, std::memory_order_relaxed); }
+		void sub(size_t n = 1) noexcept { value_.fetch_sub(n, std::memory_order_relaxed); }
+		size_t get() const noexcept { return value_.load(std::memory_order_relaxed); }
+#else
+		void add(size_t = 1) noexcept {}
+		void sub(size_t = 1) noexcept {}
+		size_t get() const noexcept { return 0; }
+#endif
+	};
+
+	// 带峰值的计数器，用于统计存活字节数
+	struct _Stat_gauge {
+#if _MSTD_ALLOC_STATS
+		std::atomic<size_t> value_{ 0 };
+		std::atomic<size_t> peak_{ 0 };
+
+		void add(size_t n) noexcept {
+			const size_t now = value_.fetch_add(n, std::memory_order_relaxed) + n;
+			size_t peak = peak_.load(std::memory_order_relaxed);
+			while (peak < now && !peak_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+		}
+		void sub(size_t n) noexcept { value_.fetch_sub(n, std::memory_order_relaxed); }
+		size_t get() const noexcept { return value_.load(std::memory_order_relaxed); }
+		size_t peak() const noexcept { return peak_.load(std::memory_order_relaxed); }
+#else
+		void add(size_t) noexcept {}
+		void sub(size_t) noexcept {}
+		size_t get() const noexcept { return 0; }
+		size_t peak() const noexcept { return 0; }
+#endif
+	};
+
+	// 单个大小类别的统计
+	struct alloc_class_stats {
+		size_t size = 0;		// 类别内存块大小
+		size_t allocs = 0;
+		size_t frees = 0;
+		size_t free_blocks = 0;	// 中心自由链表中的空闲块数
+	};
+
+	// 分配器统计快照，由 malloc_allocator::stats() / pool_allocator::stats() 返回
+	struct alloc_stats {
+		bool enabled = _MSTD_ALLOC_STATS != 0;
+		size_t allocs = 0;
+		size_t frees = 0;
+		size_t bytes_live = 0;		// 已分配未释放的字节数(内存池按类别大小计)
+		size_t peak_bytes = 0;		// bytes_live 的峰值
+		size_t refills = 0;			// 内存池切分新内存块的次数
+		size_t chunk_allocs = 0;	// 内存池向系统申请 chunk 的次数
+		size_t oom_calls = 0;		// oom_handler 调用次数
+		size_t heap_bytes = 0;		// 内存池当前持有的 chunk 总字节数
+		size_t free_list_bytes = 0;	// 滞留在中心自由链表中的字节数
+		size_t pool_bytes = 0;		// 内存池游标 [start, end) 中尚未切分的字节数
+		size_t cached_bytes = 0;	// 滞留在线程缓存中的字节数
+		std::vector<alloc_class_stats> classes;
+
+		// 碎片率：内存池持有但未被使用的字节占比
+		double fragmentation() const noexcept {
+			if (0 == heap_bytes) { return 0.0; }
+			return static_cast<double>(free_list_bytes + pool_bytes + cached_bytes) / heap_bytes;
+		}
+
+		void dump(std::ostream& os) const {
+			os << "allocs: " << allocs << "\n"
+				<< "frees: " << frees << "\n"
+				<< "bytes_live: " << bytes_live << "\n"
+				<< "peak_bytes: " << peak_bytes << "\n"
+				<< "refills: " << refills << "\n"
+				<< "chunk_allocs: " << chunk_allocs << "\n"
+				<< "oom_calls: " << oom_calls << "\n"
+				<< "heap_bytes: " << heap_bytes << "\n"
+				<< "free_list_bytes: " << free_list_bytes << "\n"
+				<< "pool_bytes: " << pool_bytes << "\n"
+				<< "cached_bytes: " << cached_bytes << "\n"
+				<< "fragmentation: " << fragmentation() << "\n";
+			for (const auto& cls : classes) {
+				os << "  [" << cls.size << "] allocs: " << cls.allocs << " frees: " << cls.frees
+					<< " free_blocks: " << cls.free_blocks << "\n";
+			}
+		}
+
+		void dump_json(std::ostream& os) const {
+			os << "{\"enabled\":" << (enabled ? "true" : "false")
+				<< ",\"allocs\":" << allocs
+				<< ",\"frees\":" << frees
+				<< ",\"bytes_live\":" << bytes_live
+				<< ",\"peak_bytes\":" << peak_bytes
+				<< ",\"refills\":" << refills
+				<< ",\"chunk_allocs\":" << chunk_allocs
+				<< ",\"oom_calls\":" << oom_calls
+				<< ",\"heap_bytes\":" << heap_bytes
+				<< ",\"free_list_bytes\":" << free_list_bytes
+				<< ",\"pool_bytes\":" << pool_bytes
+				<< ",\"cached_bytes\":" << cached_bytes
+				<< ",\"fragmentation\":" << fragmentation()
+				<< ",\"classes\":[";
+			for (size_t i = 0; i < classes.size(); ++i) {
+				if (i != 0) { os << ","; }
+				os << "{\"size\":" << classes[i].size
+					<< ",\"allocs\":" << classes[i].allocs
+					<< ",\"frees\":" << classes[i].frees
+					<< ",\"free_blocks\":" << classes[i].free_blocks << "}";
+			}
+			os << "]}";
+		}
+	};
+
+	// 第一级分配器
 	template <int inst>
 	class malloc_allocator
 	{
@@ -19,37 +153,92 @@ namespace mstd {
 		static void* allocate(size_t num_bytes) {
 			if (0 == num_bytes) { return nullptr; }
 			void* result = std::malloc(num_bytes);
-			if (nullptr == result) oom_malloc(num_bytes);
+			if (nullptr == result) result = oom_malloc(num_bytes);
+			stat_allocs.add();
+			stat_bytes.add(num_bytes);
 			return result;
 		}
 
 		static void* reallocate(void* p, size_t old_sz, size_t new_sz) {
-			if (nullptr == p) { return; }
+			if (nullptr == p) { return allocate(new_sz); }
 			void* result = std::realloc(p, new_sz);
-			if (nullptr == result) oom_realloc(p, new_sz);
+			if (nullptr == result) result = oom_realloc(p, new_sz);
+			stat_bytes.sub(old_sz);
+			stat_bytes.add(new_sz);
 			return result;
 		}
 
-		static void deallocate(void* p, size_t) {
-			if (nullptr != p) { std::free(p); }
+		static void deallocate(void* p, size_t num_bytes) {
+			if (nullptr != p) {
+				std::free(p);
+				stat_frees.add();
+				stat_bytes.sub(num_bytes);
+			}
 		}
-		// ڴ治ʱĴ
+		// p实际可用的字节数(不小于num_bytes)，多出的部分计入统计，之后按返回值归还
+		static size_t expand_to_usable(void* p, size_t num_bytes) noexcept {
+			if (nullptr == p) { return num_bytes; }
+#if defined(__GLIBC__)
+			const size_t usable = malloc_usable_size(p);
+#elif defined(_WIN32)
+			const size_t usable = _msize(p);
+#elif defined(__APPLE__)
+			const size_t usable = malloc_size(p);
+#else
+			const size_t usable = num_bytes;
+#endif
+			if (usable <= num_bytes) { return num_bytes; }
+			stat_bytes.add(usable - num_bytes);
+			return usable;
+		}
+
+		// 设置内存不足时的处理函数
 		static oom_handler_t set_oom_handler(oom_handler_t);
 
 		static void* oom_malloc(size_t);
 		static void* oom_realloc(void*, size_t);
 		static oom_handler_t oom_handler;
+
+		// 统计快照，_MSTD_ALLOC_STATS 为0时计数均为0
+		static alloc_stats stats() {
+			alloc_stats result{};
+			result.allocs = stat_allocs.get();
+			result.frees = stat_frees.get();
+			result.bytes_live = stat_bytes.get();
+			result.peak_bytes = stat_bytes.peak();
+			result.oom_calls = stat_oom_calls.get();
+			return result;
+		}
+
+	private:
+		static _Stat_counter stat_allocs;
+		static _Stat_counter stat_frees;
+		static _Stat_counter stat_oom_calls;
+		static _Stat_gauge stat_bytes;
 	};
 
 	template<int inst>
 	typename malloc_allocator<inst>::oom_handler_t malloc_allocator<inst>::oom_handler = nullptr;
 
+	template<int inst>
+	_Stat_counter malloc_allocator<inst>::stat_allocs{};
+
+	template<int inst>
+	_Stat_counter malloc_allocator<inst>::stat_frees{};
+
+	template<int inst>
+	_Stat_counter malloc_allocator<inst>::stat_oom_calls{};
+
+	template<int inst>
+	_Stat_gauge malloc_allocator<inst>::stat_bytes{};
+
 	template <int inst>
 	void* malloc_allocator<inst>::oom_realloc(void* p, size_t n)
 	{
 		void* result = nullptr;
 		while (true) {
 			if (nullptr == oom_handler) throw std::bad_alloc{};
+			stat_oom_calls.add();
 			oom_handler();
 			result = std::realloc(p, n);
 			if (result) return result;
@@ -62,6 +251,7 @@ namespace mstd {
 		void* result = nullptr;
 		while (true) {
 			if (nullptr == oom_handler) throw std::bad_alloc{};
+			stat_oom_calls.add();
 			oom_handler();
 			result = std::malloc(n);
 			if (result) return result;
@@ -77,69 +267,403 @@ namespace mstd {
 		return old;
 	}
 
-	// ڶ
-	template <int inst>
+	// 带版本号的无锁栈(Treiber stack)，Node 需要有 next 成员
+	// 栈顶指针与版本号打包进一个 64 位字：64 位平台用户态地址只用到低 48 位，
+	// 高 16 位存放版本号；32 位平台高 32 位存放版本号。每次修改栈顶版本号加一，防止 ABA 问题
+	template <class Node>
+	class _Tagged_stack
+	{
+	private:
+		static constexpr unsigned PTR_BITS = sizeof(void*) == 8 ? 48 : 32;
+		static constexpr std::uint64_t PTR_MASK = (std::uint64_t(1) << PTR_BITS) - 1;
+
+		// 两者各占一个缓存行：pop 修改 readers_ 时不会使其他线程缓存的 head_ 失效
+		alignas(64) std::atomic<std::uint64_t> head_{ 0 };
+		alignas(64) std::atomic<size_t> readers_{ 0 };	// 正在执行 pop 的线程数
+
+		static Node* get_ptr(std::uint64_t word) noexcept {
+			return reinterpret_cast<Node*>(static_cast<std::uintptr_t>(word & PTR_MASK));
+		}
+
+		static std::uint64_t make_word(Node* ptr, std::uint64_t old_word) noexcept {
+			return (((old_word >> PTR_BITS) + 1) << PTR_BITS) |
+				static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr));
+		}
+
+	public:
+		bool empty() const noexcept {
+			return nullptr == get_ptr(head_.load(std::memory_order_relaxed));
+		}
+
+		// 将[first, last]链表整体压栈
+		void push_chain(Node* first, Node* last) noexcept {
+			std::uint64_t old_word = head_.load(std::memory_order_relaxed);
+			do {
+				last->next = get_ptr(old_word);
+			} while (!head_.compare_exchange_weak(old_word, make_word(first, old_word),
+				std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		void push(Node* node) noexcept { push_chain(node, node); }
+
+		// 弹出栈顶节点。读取 top->next 时该节点可能已被其他线程取走，
+		// 但内存块不会在 pop 期间归还系统(见 wait_for_readers)，读到的旧值会因版本号不一致而使 CAS 失败
+		Node* pop() noexcept {
+			readers_.fetch_add(1);
+			std::uint64_t old_word = head_.load(std::memory_order_acquire);
+			Node* top = get_ptr(old_word);
+			while (nullptr != top &&
+				!head_.compare_exchange_weak(old_word, make_word(top->next, old_word),
+					std::memory_order_acquire, std::memory_order_acquire)) {
+				top = get_ptr(old_word);
+			}
+			readers_.fetch_sub(1, std::memory_order_release);
+			return top;
+		}
+
+		// 取走整条链表
+		Node* pop_all() noexcept {
+			std::uint64_t old_word = head_.load(std::memory_order_relaxed);
+			while (!head_.compare_exchange_weak(old_word, make_word(nullptr, old_word))) {}
+			return get_ptr(old_word);
+		}
+
+		// 弹出至多 n 个节点，返回以 nullptr 结尾的链表，count 返回实际个数。
+		// 用 pop_all 一次取走整条链表，在本线程内截取前 n 个，剩余部分放回：
+		// 期间没有其他线程压栈时一次 CAS 即可放回，否则遍历剩余部分找到尾节点后整体压栈。
+		// 不读取仍在栈中的节点，因此不需要登记为 readers_
+		Node* pop_batch(size_t n, size_t& count) noexcept {
+			std::uint64_t old_word = head_.load(std::memory_order_relaxed);
+			while (nullptr != get_ptr(old_word) &&
+				!head_.compare_exchange_weak(old_word, make_word(nullptr, old_word),
+					std::memory_order_acquire, std::memory_order_relaxed)) {}
+			Node* const first = get_ptr(old_word);
+			count = 0;
+			if (nullptr == first) { return nullptr; }
+
+			Node* last = first;
+			for (count = 1; count < n && nullptr != last->next; ++count) { last = last->next; }
+			Node* const rest = last->next;
+			last->next = nullptr;
+			if (nullptr != rest) {
+				std::uint64_t empty_word = make_word(nullptr, old_word);
+				if (!head_.compare_exchange_strong(empty_word, make_word(rest, empty_word),
+					std::memory_order_release, std::memory_order_relaxed)) {
+					Node* rest_last = rest;
+					while (nullptr != rest_last->next) { rest_last = rest_last->next; }
+					push_chain(rest, rest_last);
+				}
+			}
+			return first;
+		}
+
+		// 等待 pop_all 之前开始的 pop 全部结束，之后取走的节点不会再被其他线程读取
+		void wait_for_readers() const noexcept {
+			while (0 != readers_.load()) {
+				std::this_thread::yield();
+			}
+		}
+	};
+
+	// 内存池大小类别策略，需要提供：
+	// align		最小对齐，也是最小的内存块大小
+	// max_bytes	内存池管理的最大内存块，更大的请求交给一级分配器
+	// n_classes	大小类别(自由链表)个数
+	// n_obj		线程缓存每次与中心池交换的内存块个数
+	// min_n_obj/max_n_obj	每个类别refill批量的初值与上限，类别每refill一次批量翻倍
+	// class_index(size) 请求大小所属类别；class_size(index) 类别的内存块大小
+
+	// 线性大小类别：Align, 2*Align, ..., MaxBytes
+	template <size_t Align = 8, size_t MaxBytes = 128, size_t NObj = PoolSize,
+		size_t MinNObj = 4, size_t MaxNObj = 16 * PoolSize>
+	struct pool_linear_policy {
+		static_assert(Align >= sizeof(void*) && (Align & (Align - 1)) == 0,
+			"Align must be a power of two no less than sizeof(void*).");
+		static_assert(MaxBytes % Align == 0, "MaxBytes must be a multiple of Align.");
+
+		static constexpr size_t align = Align;
+		static constexpr size_t max_bytes = MaxBytes;
+		static constexpr size_t n_classes = MaxBytes / Align;
+		static constexpr size_t n_obj = NObj;
+		static constexpr size_t min_n_obj = MinNObj;
+		static constexpr size_t max_n_obj = MaxNObj;
+
+		static_assert(0 < MinNObj && MinNObj <= MaxNObj, "MinNObj must be in (0, MaxNObj].");
+
+		static constexpr size_t class_index(size_t size) noexcept {
+			assert(size <= MaxBytes);
+			return (size + Align - 1) / Align - 1;
+		}
+
+		static constexpr size_t class_size(size_t index) noexcept {
+			return (index + 1) * Align;
+		}
+	};
+
+	// 几何大小类别的计算，放在策略类之外，保证在策略类内部使用时已是完整定义
+	template <size_t MaxBytes, size_t Steps, size_t Align>
+	struct _Geometric_size_classes {
+		static constexpr size_t BASE = Steps * Align;
+
+		static constexpr size_t size_of(size_t index) noexcept {
+			if (index < Steps) { return (index + 1) * Align; }
+			const size_t lower = BASE << ((index - Steps) / Steps);
+			return lower + ((index - Steps) % Steps + 1) * (lower / Steps);
+		}
+
+		static constexpr size_t count_classes() noexcept {
+			size_t index = 0;
+			while (size_of(index) < MaxBytes) { ++index; }
+			return index + 1;
+		}
+
+		struct index_table {
+			unsigned char index[MaxBytes / Align + 1]{};
+		};
+
+		// 以 size/Align 为下标的类别查找表
+		static constexpr index_table make_table() noexcept {
+			index_table table{};
+			size_t index = 0;
+			for (size_t i = 1; i <= MaxBytes / Align; ++i) {
+				while (size_of(index) < i * Align) { ++index; }
+				table.index[i] = static_cast<unsigned char>(index);
+			}
+			return table;
+		}
+	};
+
+	// 几何大小类别：Steps*Align 以内按 Align 线性增长，之后每个2的幂区间均分为 Steps 份
+	// 如 Align=8, Steps=4: 8 16 24 32 | 40 48 56 64 | 80 96 112 128 | 160 192 224 256 | 320 384 448 512
+	template <size_t MaxBytes = 512, size_t Steps = 4, size_t Align = 8, size_t NObj = PoolSize,
+		size_t MinNObj = 4, size_t MaxNObj = 16 * PoolSize>
+	struct pool_geometric_policy {
+	private:
+		using classes = _Geometric_size_classes<MaxBytes, Steps, Align>;
+
+		static constexpr typename classes::index_table table = classes::make_table();
+
+	public:
+		static_assert(Align >= sizeof(void*) && (Align & (Align - 1)) == 0,
+			"Align must be a power of two no less than sizeof(void*).");
+		static_assert(Steps > 0 && (classes::BASE & (classes::BASE - 1)) == 0,
+			"Steps * Align must be a power of two.");
+
+		static constexpr size_t align = Align;
+		static constexpr size_t n_classes = classes::count_classes();
+		static constexpr size_t max_bytes = classes::size_of(n_classes - 1);
+		static constexpr size_t n_obj = NObj;
+		static constexpr size_t min_n_obj = MinNObj;
+		static constexpr size_t max_n_obj = MaxNObj;
+
+		static_assert(0 < MinNObj && MinNObj <= MaxNObj, "MinNObj must be in (0, MaxNObj].");
+
+		static_assert(max_bytes == MaxBytes, "MaxBytes must be one of the generated class sizes.");
+		static_assert(n_classes <= 256, "too many size classes.");
+
+		// 查表，O(1)；表只覆盖 [0, MaxBytes]
+		static constexpr size_t class_index(size_t size) noexcept {
+			assert(size <= MaxBytes);
+			return table.index[(size + Align - 1) / Align];
+		}
+
+		static constexpr size_t class_size(size_t index) noexcept {
+			return classes::size_of(index);
+		}
+	};
+
+	template <int inst, class Policy = pool_linear_policy<>>
+	class thread_cache_allocator;
+
+	// 第二级分配器
+	template <int inst, class Policy = pool_linear_policy<>>
 	class pool_allocator
 	{
 	private:
-		enum { UP_BORDER = 8 };
-		enum { MAX_BYTES = 128 };
-		enum { NFREELISTS = 16 }; // MAX_BYTES/UP_BORDER
+		friend class thread_cache_allocator<inst, Policy>;
+
+		enum : size_t { MAX_BYTES = Policy::max_bytes };
+		enum : size_t { NFREELISTS = Policy::n_classes };
 
-		struct obj { //free-lists Ľڵ
+		struct obj { //free-lists 的节点
 			obj* next;
 		};
-		//16free-list
-		static obj* free_list[NFREELISTS];
+		//NFREELISTS个free-list，无锁栈，跨线程释放不需要加锁
+		static _Tagged_stack<obj> free_list[NFREELISTS];
 
-		//round_upڴСϵ8ı
+		//每次向系统申请的大块内存(chunk)头部，所有chunk串成链表，trim时据此判断整块是否空闲
+		struct alignas(16) chunk_header {
+			chunk_header* next;
+			size_t bytes;		// chunk_header之后可切分的字节数
+			size_t free_bytes;	// trim时统计的空闲字节数
+		};
+		static chunk_header* chunk_list;
+
+		//round_up将申请内存大小上调至所属类别的大小
 		static size_t round_up(size_t size) {
-			return (size + UP_BORDER - 1) & ~(UP_BORDER - 1);
+			return Policy::class_size(Policy::class_index(size));
 		}
 
-		//free_list_indexڴС
+		//free_list_index返回申请内存大小所属的自由链表索引
 		static size_t free_list_index(size_t size) {
-			return (size + UP_BORDER - 1) / UP_BORDER - 1;
+			return Policy::class_index(size);
 		}
 
-		//¼ڴص״̬ end - start ʾڴص
+		//记录内存池的状态， end - start 表示内存池的容量
 		static char* start;
 		static char* end;
-		static size_t heap_size; // ¼Ķڴ
+		static size_t heap_size; // 记录申请的堆内存总量
+
+		//每个类别下一次refill的内存块个数，从 min_n_obj 开始每次refill翻倍，直到 max_n_obj
+		//冷门类别保持小批量不浪费内存，热门类别很快以大批量减少进入chunk_alloc的次数
+		//受 chunk_mutex 保护
+		static size_t refill_batch[NFREELISTS];
+
+		//取得类别index本次refill的批量，并让下一次翻倍，需持有 chunk_mutex
+		static size_t next_batch(size_t index) noexcept {
+			size_t batch = refill_batch[index];
+			if (0 == batch) { batch = Policy::min_n_obj; }
+			refill_batch[index] = batch < Policy::max_n_obj / 2 ? 2 * batch : Policy::max_n_obj;
+			return batch;
+		}
+
+		//保护 start/end/heap_size/chunk_list，只有 free_list 为空需要切分新内存或 trim 时才加锁
+		static std::mutex chunk_mutex;
+
+		//后台 trim 线程，析构时停止并回收线程
+		struct trim_worker {
+			std::thread worker;
+			std::mutex config_mtx;	// 串行化 set_background_trim
+			std::mutex mtx;
+			std::condition_variable cv;
+			std::chrono::milliseconds interval{ 0 };
+			size_t keep_bytes = 0;
+			bool stop = false;
+
+			~trim_worker() { shutdown(); }
+			void shutdown() {
+				{
+					std::lock_guard<std::mutex> lock(mtx);
+					stop = true;
+				}
+				cv.notify_all();
+				if (worker.joinable()) { worker.join(); }
+				stop = false;
+			}
+			void run();
+		};
 
-		//ÿmalloc 2*n_obj*size Сڴ
-		static const size_t n_obj;
+		//第一次调用 set_background_trim 时才构造，晚于 chunk_mutex 和自由链表，因此先于它们析构：
+		//程序退出时先停止并回收线程，正在执行的 trim() 不会访问已析构的 chunk_mutex
+		static trim_worker& trimmer() {
+			static trim_worker worker;
+			return worker;
+		}
 
-		//chunk_allocһڴ棬ڴ׵ַڴ״̬
+		//chunk_alloc分配一块内存，返回内存首地址，并调整内存池状态
 		static void* chunk_alloc(size_t size, size_t& m_n_obj);
 
-		//refillchunk_allocصڴиС飬ͬʱڴ׵ַ
+		//refill将chunk_alloc返回的内存块切割成小块，并串成链表，同时返回请求的内存块首地址
 		static void* refill(size_t size);
 
+		//carve将chunk_alloc返回的m_n_obj个内存块串成以nullptr结尾的链表，last返回尾节点
+		static obj* carve(char* chunk, size_t size, size_t m_n_obj, obj*& last) noexcept;
+
+		//fetch_batch从中心池取出至多m_n_obj个内存块，串成以nullptr结尾的链表返回，m_n_obj返回实际个数
+		static obj* fetch_batch(size_t size, size_t& m_n_obj);
+
+		//release_batch将[first, last]共m_n_obj个内存块的链表整体归还中心池
+		static void release_batch(size_t size, obj* first, obj* last, size_t m_n_obj) noexcept;
+
+		//统计计数，只统计不超过 MAX_BYTES 的请求，更大的请求计入 malloc_allocator 的统计
+		struct class_counters {
+			_Stat_counter allocs;
+			_Stat_counter frees;
+			_Stat_counter free_blocks; // 先加后 push、先 pop 后减，保证计数不小于实际个数
+		};
+		static class_counters class_stats[NFREELISTS];
+		static _Stat_counter stat_allocs;
+		static _Stat_counter stat_frees;
+		static _Stat_counter stat_refills;
+		static _Stat_counter stat_chunk_allocs;
+		static _Stat_gauge stat_bytes;
+
+		static void count_alloc(size_t index, size_t num = 1) noexcept {
+			class_stats[index].allocs.add(num);
+			stat_allocs.add(num);
+			stat_bytes.add(num * Policy::class_size(index));
+		}
+
+		static void count_free(size_t index, size_t num = 1) noexcept {
+			class_stats[index].frees.add(num);
+			stat_frees.add(num);
+			stat_bytes.sub(num * Policy::class_size(index));
+		}
+
 	public:
 		static void* allocate(size_t size);
 		static void* reallocate(void* p, size_t old_sz, size_t new_sz);
 		static void deallocate(void* p, size_t size);
+
+		//将所有块都已空闲的chunk归还系统，返回归还的字节数
+		//线程缓存中的内存块不在统计范围内，需要先调用 thread_cache_allocator::flush()
+		static size_t trim();
+
+		//后台每隔 interval 检查一次，当池占用超过 keep_bytes 时调用 trim()，interval 为0时停止
+		static void set_background_trim(std::chrono::milliseconds interval, size_t keep_bytes = 0);
+
+		//当前向系统申请的内存总量
+		static size_t heap_bytes() noexcept {
+			std::lock_guard<std::mutex> lock(chunk_mutex);
+			return heap_size;
+		}
+
+		//统计快照，heap_bytes/pool_bytes 总是有效，其余计数需要开启 _MSTD_ALLOC_STATS
+		static alloc_stats stats();
 	};
 
-	template <int inst>
-	typename pool_allocator<inst>::obj*
-		pool_allocator<inst>::free_list[NFREELISTS]{};
+	template <int inst, class Policy>
+	_Tagged_stack<typename pool_allocator<inst, Policy>::obj>
+		pool_allocator<inst, Policy>::free_list[NFREELISTS]{};
 
-	template <int inst>
-	char* pool_allocator<inst>::start = nullptr;
+	template <int inst, class Policy>
+	char* pool_allocator<inst, Policy>::start = nullptr;
 
-	template <int inst>
-	char* pool_allocator<inst>::end = nullptr;
+	template <int inst, class Policy>
+	char* pool_allocator<inst, Policy>::end = nullptr;
 
-	template <int inst>
-	size_t pool_allocator<inst>::heap_size = 0;
+	template <int inst, class Policy>
+	size_t pool_allocator<inst, Policy>::heap_size = 0;
 
-	template <int inst>
-	const size_t pool_allocator<inst>::n_obj = PoolSize;
+	template <int inst, class Policy>
+	size_t pool_allocator<inst, Policy>::refill_batch[NFREELISTS]{};
 
-	template <int inst>
-	void* pool_allocator<inst>::chunk_alloc(size_t size, size_t& m_n_obj)
+	template <int inst, class Policy>
+	typename pool_allocator<inst, Policy>::chunk_header* pool_allocator<inst, Policy>::chunk_list = nullptr;
+
+	template <int inst, class Policy>
+	std::mutex pool_allocator<inst, Policy>::chunk_mutex{};
+
+	template <int inst, class Policy>
+	typename pool_allocator<inst, Policy>::class_counters pool_allocator<inst, Policy>::class_stats[NFREELISTS]{};
+
+	template <int inst, class Policy>
+	_Stat_counter pool_allocator<inst, Policy>::stat_allocs{};
+
+	template <int inst, class Policy>
+	_Stat_counter pool_allocator<inst, Policy>::stat_frees{};
+
+	template <int inst, class Policy>
+	_Stat_counter pool_allocator<inst, Policy>::stat_refills{};
+
+	template <int inst, class Policy>
+	_Stat_counter pool_allocator<inst, Policy>::stat_chunk_allocs{};
+
+	template <int inst, class Policy>
+	_Stat_gauge pool_allocator<inst, Policy>::stat_bytes{};
+
+	template <int inst, class Policy>
+	void* pool_allocator<inst, Policy>::chunk_alloc(size_t size, size_t& m_n_obj)
 	{
 		size_t total_bytes = m_n_obj * size;
 		size_t bytes_left = end - start;
@@ -156,113 +680,640 @@ namespace mstd {
 			return result;
 		}
 		else {
-			if (bytes_left > 0) { // СsizeСڴռӦ
-				auto m_free_list = free_list + free_list_index(bytes_left);
-				auto temp = reinterpret_cast<obj*>(start);
-				temp->next = *m_free_list;
-				*m_free_list = temp;
+			// 将小于size大小的内存池剩余空间按不超过剩余大小的最大类别切分，放入对应的自由链表
+			for (size_t index = free_list_index(size); bytes_left > 0; ) {
+				while (Policy::class_size(index) > bytes_left) { --index; }
+				class_stats[index].free_blocks.add();
+				free_list[index].push(reinterpret_cast<obj*>(start));
+				start += Policy::class_size(index);
+				bytes_left -= Policy::class_size(index);
 			}
 			size_t bytes_to_get = 2 * m_n_obj * size;
-			result = static_cast<char*>(std::malloc(bytes_to_get));
+			result = static_cast<char*>(std::malloc(sizeof(chunk_header) + bytes_to_get));
 			if (nullptr == result) {
-				//ѰұsizeڴǷппռ
-				for (auto sz = size; sz <= 128; sz += UP_BORDER) {
-					auto m_free_list = free_list_index(sz) + free_list;
-					if (nullptr != *m_free_list) {
-						start = reinterpret_cast<char*>(*m_free_list);
-						end = start + sz;
-						*m_free_list = (*m_free_list).next;
+				//寻找比size大的内存块自由链表，查看是否有空闲空间
+				for (auto index = free_list_index(size); index < NFREELISTS; ++index) {
+					obj* block = free_list[index].pop();
+					if (nullptr != block) {
+						class_stats[index].free_blocks.sub();
+						start = reinterpret_cast<char*>(block);
+						end = start + Policy::class_size(index);
 						return chunk_alloc(size, m_n_obj);
 					}
 				}
-				//ʵҲڴ棬һڴ棬 out of memory handler
-				//׳ bad_alloc 쳣
-				start = static_cast<char*>(malloc_allocator<inst>::
-					allocate(bytes_to_get));
-				if (nullptr != start) {
-					end = start + bytes_to_get;
-					heap_size += bytes_to_get;
-					return chunk_alloc(size, m_n_obj);
-				}
+				//实在找不到内存，交给一级分配器的 out of memory handler 处理
+				//或者抛出 bad_alloc 异常，chunk 不计入一级分配器的统计
+				result = static_cast<char*>(malloc_allocator<inst>::
+					oom_malloc(sizeof(chunk_header) + bytes_to_get));
 			}
-			end = result + bytes_to_get;
+			stat_chunk_allocs.add();
+			auto header = reinterpret_cast<chunk_header*>(result);
+			header->next = chunk_list;
+			header->bytes = bytes_to_get;
+			header->free_bytes = 0;
+			chunk_list = header;
+			start = result + sizeof(chunk_header);
+			end = start + bytes_to_get;
 			heap_size += bytes_to_get;
 			return chunk_alloc(size, m_n_obj);
 		}
 	}
 
-	template <int inst>
-	void* pool_allocator<inst>::refill(size_t size)
+	template <int inst, class Policy>
+	typename pool_allocator<inst, Policy>::obj*
+		pool_allocator<inst, Policy>::carve(char* chunk, size_t size, size_t m_n_obj, obj*& last) noexcept
+	{
+		for (size_t i = 0; i + 1 < m_n_obj; ++i) {
+			reinterpret_cast<obj*>(chunk + i * size)->next =
+				reinterpret_cast<obj*>(chunk + (i + 1) * size);
+		}
+		last = reinterpret_cast<obj*>(chunk + (m_n_obj - 1) * size);
+		last->next = nullptr;
+		return reinterpret_cast<obj*>(chunk);
+	}
+
+	template <int inst, class Policy>
+	void* pool_allocator<inst, Policy>::refill(size_t size)
 	{
-		size_t m_n_obj = n_obj;
-		void* result = chunk_alloc(size, m_n_obj);
+		size_t m_n_obj = 0;
+		char* result = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(chunk_mutex);
+			m_n_obj = next_batch(free_list_index(size));
+			result = static_cast<char*>(chunk_alloc(size, m_n_obj));
+		}
+		stat_refills.add();
 		if (1 == m_n_obj) { return result; }
-		auto temp = static_cast<char*>(result);
-		size_t i = 1;
-		for (; i < m_n_obj - 1; ++i) {
-			reinterpret_cast<obj*>(temp + i * size).next =
-				reinterpret_cast<obj*>(temp + (i + 1) * size);
-		}
-		reinterpret_cast<obj*>(temp + i * size).next = nullptr;
-		auto m_free_list = free_list + free_list_index(size);
-		*m_free_list = reinterpret_cast<obj*>(temp + size);
+		obj* last = nullptr;
+		obj* first = carve(result + size, size, m_n_obj - 1, last);
+		class_stats[free_list_index(size)].free_blocks.add(m_n_obj - 1);
+		free_list[free_list_index(size)].push_chain(first, last);
 		return result;
 	}
 
-	template <int inst>
-	void* pool_allocator<inst>::allocate(size_t size)
+	template <int inst, class Policy>
+	typename pool_allocator<inst, Policy>::obj*
+		pool_allocator<inst, Policy>::fetch_batch(size_t size, size_t& m_n_obj)
 	{
-		if (0 == size) { return; }
+		size_t count = 0;
+		obj* result = free_list[free_list_index(size)].pop_batch(m_n_obj, count);
+		if (nullptr != result) { // 自由链表中有空闲块，整批取走至多m_n_obj个
+			class_stats[free_list_index(size)].free_blocks.sub(count);
+			m_n_obj = count;
+			return result;
+		}
+		//自由链表为空时按该类别的自适应批量切分，多于请求的部分放入自由链表
+		size = round_up(size);
+		char* chunk = nullptr;
+		size_t carved = 0;
+		{
+			std::lock_guard<std::mutex> lock(chunk_mutex);
+			carved = next_batch(free_list_index(size));
+			if (carved < m_n_obj) { carved = m_n_obj; }
+			chunk = static_cast<char*>(chunk_alloc(size, carved));
+		}
+		stat_refills.add();
+		obj* last = nullptr;
+		if (carved > m_n_obj) {
+			obj* first = carve(chunk + m_n_obj * size, size, carved - m_n_obj, last);
+			class_stats[free_list_index(size)].free_blocks.add(carved - m_n_obj);
+			free_list[free_list_index(size)].push_chain(first, last);
+		}
+		else {
+			m_n_obj = carved;
+		}
+		return carve(chunk, size, m_n_obj, last);
+	}
+
+	template <int inst, class Policy>
+	void pool_allocator<inst, Policy>::release_batch(size_t size, obj* first, obj* last, size_t m_n_obj) noexcept
+	{
+		class_stats[free_list_index(size)].free_blocks.add(m_n_obj);
+		free_list[free_list_index(size)].push_chain(first, last);
+	}
+
+	template <int inst, class Policy>
+	size_t pool_allocator<inst, Policy>::trim()
+	{
+		std::lock_guard<std::mutex> lock(chunk_mutex);
+		size_t n_chunks = 0;
+		for (auto h = chunk_list; nullptr != h; h = h->next) { ++n_chunks; }
+		if (0 == n_chunks) { return 0; }
+		auto chunks = static_cast<std::uintptr_t*>(std::malloc(n_chunks * sizeof(std::uintptr_t)));
+		if (nullptr == chunks) { return 0; }
+
+		//取走所有空闲块，并等待正在读取这些块的 pop 结束
+		obj* blocks[NFREELISTS];
+		for (size_t i = 0; i < NFREELISTS; ++i) {
+			blocks[i] = free_list[i].pop_all();
+		}
+		for (size_t i = 0; i < NFREELISTS; ++i) {
+			free_list[i].wait_for_readers();
+		}
+
+		//按地址排序，二分查找内存块所属的chunk。
+		//排序整数地址而不是 chunk_header*：指向 mstd 类型的指针会让 std::sort 内部按 ADL 同时找到 std::swap 和 mstd::swap
+		size_t n = 0;
+		for (auto h = chunk_list; nullptr != h; h = h->next) {
+			h->free_bytes = 0;
+			chunks[n++] = reinterpret_cast<std::uintptr_t>(h);
+		}
+		std::sort(chunks, chunks + n_chunks);
+		auto find_chunk = [chunks, n_chunks](const void* p) -> chunk_header* {
+			auto iter = std::upper_bound(chunks, chunks + n_chunks, reinterpret_cast<std::uintptr_t>(p));
+			if (iter == chunks) { return nullptr; }
+			chunk_header* h = reinterpret_cast<chunk_header*>(*(iter - 1));
+			auto first = reinterpret_cast<const char*>(h) + sizeof(chunk_header);
+			return static_cast<const char*>(p) < first + h->bytes ? h : nullptr;
+		};
+		auto is_free_chunk = [](const chunk_header* h) { return nullptr != h && h->free_bytes == h->bytes; };
+
+		for (size_t i = 0; i < NFREELISTS; ++i) {
+			for (obj* node = blocks[i]; nullptr != node; node = node->next) {
+				if (auto h = find_chunk(node)) { h->free_bytes += Policy::class_size(i); }
+			}
+		}
+		chunk_header* pool_chunk = start != end ? find_chunk(start) : nullptr;
+		if (nullptr != pool_chunk) { pool_chunk->free_bytes += end - start; }
+
+		//不属于空闲chunk的内存块放回自由链表
+		for (size_t i = 0; i < NFREELISTS; ++i) {
+			obj* first = nullptr;
+			obj* last = nullptr;
+			size_t dropped = 0;
+			for (obj* node = blocks[i], *next = nullptr; nullptr != node; node = next) {
+				next = node->next;
+				if (is_free_chunk(find_chunk(node))) { ++dropped; continue; }
+				node->next = first;
+				first = node;
+				if (nullptr == last) { last = node; }
+			}
+			if (nullptr != first) { free_list[i].push_chain(first, last); }
+			class_stats[i].free_blocks.sub(dropped);
+		}
+		if (is_free_chunk(pool_chunk)) { start = end = nullptr; }
+
+		size_t released = 0;
+		for (chunk_header** pnext = &chunk_list; nullptr != *pnext;) {
+			chunk_header* h = *pnext;
+			if (is_free_chunk(h)) {
+				*pnext = h->next;
+				released += h->bytes;
+				std::free(h);
+			}
+			else {
+				pnext = &h->next;
+			}
+		}
+		heap_size -= released;
+		std::free(chunks);
+		return released;
+	}
+
+	template <int inst, class Policy>
+	alloc_stats pool_allocator<inst, Policy>::stats()
+	{
+		alloc_stats result{};
+		result.allocs = stat_allocs.get();
+		result.frees = stat_frees.get();
+		result.bytes_live = stat_bytes.get();
+		result.peak_bytes = stat_bytes.peak();
+		result.refills = stat_refills.get();
+		result.chunk_allocs = stat_chunk_allocs.get();
+		result.oom_calls = malloc_allocator<inst>::stats().oom_calls;
+		result.classes.resize(NFREELISTS);
+		for (size_t i = 0; i < NFREELISTS; ++i) {
+			auto& cls = result.classes[i];
+			cls.size = Policy::class_size(i);
+			cls.allocs = class_stats[i].allocs.get();
+			cls.frees = class_stats[i].frees.get();
+			cls.free_blocks = class_stats[i].free_blocks.get();
+			result.free_list_bytes += cls.free_blocks * cls.size;
+		}
+		{
+			std::lock_guard<std::mutex> lock(chunk_mutex);
+			result.heap_bytes = heap_size;
+			result.pool_bytes = end - start;
+		}
+		//剩下的就是线程缓存中的内存块，计数不是同时读取的，结果可能略有偏差
+		const size_t accounted = result.bytes_live + result.free_list_bytes + result.pool_bytes;
+		if (result.enabled && result.heap_bytes > accounted) {
+			result.cached_bytes = result.heap_bytes - accounted;
+		}
+		return result;
+	}
+
+	template <int inst, class Policy>
+	void pool_allocator<inst, Policy>::trim_worker::run()
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		while (!cv.wait_for(lock, interval, [this] { return stop; })) {
+			if (heap_bytes() > keep_bytes) {
+				lock.unlock();
+				trim();
+				lock.lock();
+			}
+		}
+	}
+
+	template <int inst, class Policy>
+	void pool_allocator<inst, Policy>::set_background_trim(std::chrono::milliseconds interval, size_t keep_bytes)
+	{
+		trim_worker& worker = trimmer();
+		std::lock_guard<std::mutex> lock(worker.config_mtx);
+		worker.shutdown();
+		if (interval.count() <= 0) { return; }
+		worker.interval = interval;
+		worker.keep_bytes = keep_bytes;
+		worker.worker = std::thread([&worker] { worker.run(); });
+	}
+
+	template <int inst, class Policy>
+	void* pool_allocator<inst, Policy>::allocate(size_t size)
+	{
+		if (0 == size) { return nullptr; }
 		if (size > static_cast<size_t>(MAX_BYTES))
-		{//>128bytes һڴ뺯
-			malloc_allocator<inst>::allocate(size);
+		{//>128bytes 调用一级分配器的内存申请函数
+			return malloc_allocator<inst>::allocate(size);
 		}
-		obj** m_free_list = free_list + free_list_index(size);
-		obj* result = *m_free_list;
+		const size_t index = free_list_index(size);
+		count_alloc(index);
+		obj* result = free_list[index].pop();
 		if (nullptr == result) {
-			result = refill(round_up(size));
-			return result;
+			return refill(round_up(size));
 		}
-		*m_free_list = result->next;
+		class_stats[index].free_blocks.sub();
 		return result;
 	}
 
-	template <int inst>
-	void* pool_allocator<inst>::
+	template <int inst, class Policy>
+	void* pool_allocator<inst, Policy>::
 		reallocate(void* p, size_t old_sz, size_t new_sz)
+	{
+		if (nullptr == p) { return allocate(new_sz); }
+		//只有两个大小都不超过 MAX_BYTES 时才能按类别比较，round_up 不接受更大的请求
+		if (old_sz > static_cast<size_t>(MAX_BYTES) || new_sz > static_cast<size_t>(MAX_BYTES)) {
+			if (old_sz > static_cast<size_t>(MAX_BYTES) && new_sz > static_cast<size_t>(MAX_BYTES)) {
+				return malloc_allocator<inst>::reallocate(p, old_sz, new_sz);
+			}
+		}
+		else if (round_up(old_sz) == round_up(new_sz)) { return p; }
+		void* result = allocate(new_sz);
+		auto copy_sz = (old_sz > new_sz) ? new_sz : old_sz;
+		std::memcpy(result, p, copy_sz);
+		deallocate(p, old_sz);
+		return result;
+	}
+
+	template <int inst, class Policy>
+	void pool_allocator<inst, Policy>::deallocate(void* p, size_t size)
 	{
 		if (nullptr == p) { return; }
-		if (old_sz > static_cast<size_t>(MAX_BYTES) &&
-			new_sz > static_cast<size_t>(MAX_BYTES)) {
-			return malloc_allocator<inst>::reallocate(p, new_sz);
+		if (size > static_cast<size_t>(MAX_BYTES))
+		{//>128bytes 调用一级分配器的内存释放函数
+			malloc_allocator<inst>::deallocate(p, size);
+			return;
 		}
-		else {
-			void* result = nullptr;
-			if (new_sz > static_cast<size_t>(MAX_BYTES)) {
-				result = malloc_allocator<inst>::allocate(new_sz);
+		const size_t index = free_list_index(size);
+		count_free(index);
+		class_stats[index].free_blocks.add();
+		free_list[index].push(static_cast<obj*>(p));
+	}
+
+	// 线程缓存分配器：每个线程为每个大小类别维护一个弹匣(magazine)，
+	// 弹匣空时从 pool_allocator 中心池批量取回 n_obj 个内存块，
+	// 超过高水位时批量归还一半，只有批量操作才访问中心池
+	template <int inst, class Policy>
+	class thread_cache_allocator
+	{
+	private:
+		using pool = pool_allocator<inst, Policy>;
+		using obj = typename pool::obj;
+
+		enum { MAX_BYTES = pool::MAX_BYTES };
+		enum { NFREELISTS = pool::NFREELISTS };
+
+		struct magazine {
+			obj* head = nullptr;
+			size_t count = 0;
+		};
+
+		struct thread_cache {
+			magazine mags[NFREELISTS];
+
+			// 线程退出时将缓存的内存块全部归还中心池
+			~thread_cache() {
+				for (size_t i = 0; i < NFREELISTS; ++i) {
+					drain(mags[i], Policy::class_size(i), mags[i].count);
+				}
+				cache_destroyed() = true;
+			}
+		};
+
+		//每次与中心池交换的内存块个数，以及弹匣的高水位
+		static const size_t batch = Policy::n_obj;
+		static const size_t high_water = 2 * Policy::n_obj;
+
+		static thread_cache& local_cache() {
+			thread_local thread_cache cache;
+			return cache;
+		}
+
+		// 线程缓存析构后置位，此后本线程(例如其他 thread_local 对象的析构函数)直接使用中心池
+		// bool 是平凡析构的，线程退出的整个过程中都可以访问
+		static bool& cache_destroyed() noexcept {
+			thread_local bool destroyed = false;
+			return destroyed;
+		}
+
+		//将弹匣头部的num个内存块归还中心池
+		static void drain(magazine& mag, size_t size, size_t num) noexcept {
+			if (0 == num) { return; }
+			obj* first = mag.head;
+			obj* last = first;
+			for (size_t i = 1; i < num; ++i) {
+				last = last->next;
+			}
+			mag.head = last->next;
+			mag.count -= num;
+			pool::release_batch(size, first, last, num);
+		}
+
+	public:
+		//将当前线程缓存的内存块全部归还中心池，之后 pool_allocator::trim() 才能回收这些内存
+		static void flush() noexcept {
+			if (cache_destroyed()) { return; }
+			thread_cache& cache = local_cache();
+			for (size_t i = 0; i < NFREELISTS; ++i) {
+				drain(cache.mags[i], Policy::class_size(i), cache.mags[i].count);
+			}
+		}
+
+		static void* allocate(size_t size) {
+			if (0 == size) { return nullptr; }
+			if (size > static_cast<size_t>(MAX_BYTES)) {
+				return malloc_allocator<inst>::allocate(size);
+			}
+			if (cache_destroyed()) { return pool::allocate(size); }
+			const size_t index = pool::free_list_index(size);
+			pool::count_alloc(index);
+			magazine& mag = local_cache().mags[index];
+			if (nullptr == mag.head) {
+				size_t m_n_obj = batch;
+				mag.head = pool::fetch_batch(size, m_n_obj);
+				mag.count = m_n_obj;
+			}
+			obj* result = mag.head;
+			mag.head = result->next;
+			--mag.count;
+			return result;
+		}
+
+		static void* reallocate(void* p, size_t old_sz, size_t new_sz) {
+			if (nullptr == p) { return allocate(new_sz); }
+			if (old_sz > static_cast<size_t>(MAX_BYTES) || new_sz > static_cast<size_t>(MAX_BYTES)) {
+				if (old_sz > static_cast<size_t>(MAX_BYTES) && new_sz > static_cast<size_t>(MAX_BYTES)) {
+					return malloc_allocator<inst>::reallocate(p, old_sz, new_sz);
+				}
 			}
-			result = allocate(new_sz);
+			else if (pool::round_up(old_sz) == pool::round_up(new_sz)) { return p; }
+			void* result = allocate(new_sz);
 			auto copy_sz = (old_sz > new_sz) ? new_sz : old_sz;
 			std::memcpy(result, p, copy_sz);
 			deallocate(p, old_sz);
 			return result;
 		}
-	}
 
+		static void deallocate(void* p, size_t size) {
+			if (nullptr == p) { return; }
+			if (size > static_cast<size_t>(MAX_BYTES)) {
+				malloc_allocator<inst>::deallocate(p, size);
+				return;
+			}
+			if (cache_destroyed()) {
+				pool::deallocate(p, size);
+				return;
+			}
+			const size_t index = pool::free_list_index(size);
+			pool::count_free(index);
+			magazine& mag = local_cache().mags[index];
+			auto mp = static_cast<obj*>(p);
+			mp->next = mag.head;
+			mag.head = mp;
+			if (++mag.count > high_water) {
+				drain(mag, Policy::class_size(index), batch);
+			}
+		}
+	};
+
+
+	// 单调分配器：在调用者提供的缓冲区或逐步增长的内存块上移动指针分配，
+	// deallocate 只回退最后一次分配，其余为空操作，由 reset() 一次性回收。
+	// 每个线程一个 arena，容器可以在其他线程析构，但 reset() 之后不能再访问之前分配的内存
 	template <int inst>
-	void pool_allocator<inst>::deallocate(void* p, size_t size)
+	class monotonic_allocator
 	{
-		if (nullptr == p) { return; }
-		if (size > static_cast<size_t>(NFREELISTS))
-		{//>128bytes һڴͷź
-			malloc_allocator<inst>::deallocate(p, size);
-			return;
+	private:
+		struct alignas(alignof(std::max_align_t)) block {
+			block* next;
+			size_t bytes; // block之后可用的字节数
+		};
+
+		enum : size_t { ALIGN = alignof(std::max_align_t) };
+		enum : size_t { INITIAL_BLOCK = 4096 - sizeof(block) };
+		enum : size_t { MAX_BLOCK = (size_t(1) << 20) - sizeof(block) };
+
+		struct arena {
+			char* cur = nullptr;
+			char* end = nullptr;
+			char* last = nullptr;		// 最后一次分配的首地址，用于回退和原地扩展
+			block* blocks = nullptr;	// 已申请的内存块，最新的在前
+			block* spare = nullptr;		// reset 保留下来的最大内存块，下次增长时复用
+			char* buffer = nullptr;		// 调用者提供的缓冲区
+			size_t buffer_size = 0;
+			size_t next_size = INITIAL_BLOCK;
+
+			~arena() { release(*this); }
+		};
+
+		static arena& local_arena() {
+			thread_local arena a;
+			return a;
 		}
-		obj** m_free_list = free_list + free_list_index(size);
-		auto mp = static_cast<obj*>(p);
-		mp->next = *m_free_list;
-		*m_free_list = mp;
-	}
 
-}
+		static size_t round_up(size_t bytes) noexcept {
+			return (bytes + ALIGN - 1) & ~(static_cast<size_t>(ALIGN) - 1);
+		}
+
+		static char* data(block* b) noexcept {
+			return reinterpret_cast<char*>(b) + sizeof(block);
+		}
+
+		static void free_blocks(block* b) noexcept {
+			while (nullptr != b) {
+				block* next = b->next;
+				malloc_allocator<inst>::deallocate(b, sizeof(block) + b->bytes);
+				b = next;
+			}
+		}
+
+		static void release(arena& a) noexcept {
+			free_blocks(a.blocks);
+			free_blocks(a.spare);
+			a.cur = a.end = a.last = nullptr;
+			a.blocks = a.spare = nullptr;
+			a.buffer = nullptr;
+			a.buffer_size = 0;
+			a.next_size = INITIAL_BLOCK;
+		}
+
+		//当前区域不足时切换到至少 bytes 大小的新内存块，优先复用 spare
+		static void grow(arena& a, size_t bytes) {
+			block* b = nullptr;
+			if (nullptr != a.spare && a.spare->bytes >= bytes) {
+				b = a.spare;
+				a.spare = nullptr;
+			}
+			else {
+				size_t block_size = a.next_size < bytes ? round_up(bytes) : a.next_size;
+				b = static_cast<block*>(malloc_allocator<inst>::allocate(sizeof(block) + block_size));
+				b->bytes = block_size;
+				if (a.next_size < static_cast<size_t>(MAX_BLOCK)) {
+					a.next_size = 2 * a.next_size + sizeof(block);
+				}
+			}
+			b->next = a.blocks;
+			a.blocks = b;
+			a.cur = data(b);
+			a.end = a.cur + b->bytes;
+		}
+
+	public:
+		static void* allocate(size_t size) {
+			if (0 == size) { return nullptr; }
+			arena& a = local_arena();
+			size = round_up(size);
+			if (static_cast<size_t>(a.end - a.cur) < size) { grow(a, size); }
+			a.last = a.cur;
+			a.cur += size;
+			return a.last;
+		}
 
+		static void* reallocate(void* p, size_t old_sz, size_t new_sz) {
+			if (nullptr == p) { return allocate(new_sz); }
+			arena& a = local_arena();
+			//最后一次分配且剩余空间足够时原地扩展或收缩
+			if (p == a.last && static_cast<size_t>(a.end - a.last) >= round_up(new_sz)) {
+				a.cur = a.last + round_up(new_sz);
+				return p;
+			}
+			void* result = allocate(new_sz);
+			std::memcpy(result, p, (old_sz > new_sz) ? new_sz : old_sz);
+			return result;
+		}
+
+		//只有最后一次分配可以回退，其余内存直到 reset() 才回收
+		static void deallocate(void* p, size_t) noexcept {
+			arena& a = local_arena();
+			if (nullptr != p && p == a.last) {
+				a.cur = a.last;
+				a.last = nullptr;
+			}
+		}
+
+		//使用调用者提供的缓冲区作为起始区域，用尽后再向系统申请，缓冲区的生存期由调用者负责
+		static void set_buffer(void* buffer, size_t bytes) noexcept {
+			arena& a = local_arena();
+			release(a);
+			auto first = reinterpret_cast<char*>(round_up(reinterpret_cast<std::uintptr_t>(buffer)));
+			if (first >= static_cast<char*>(buffer) + bytes) { return; }
+			a.buffer = first;
+			a.buffer_size = static_cast<char*>(buffer) + bytes - first;
+			a.cur = a.buffer;
+			a.end = a.buffer + a.buffer_size;
+		}
+
+		//一次性回收当前线程分配的全部内存，保留最大的内存块供下次使用
+		static void reset() noexcept {
+			arena& a = local_arena();
+			block* keep = a.blocks;
+			if (nullptr != keep) {
+				free_blocks(keep->next);
+				keep->next = nullptr;
+				if (nullptr != a.spare && a.spare->bytes > keep->bytes) { std::swap(keep, a.spare); }
+				free_blocks(a.spare);
+			}
+			else {
+				keep = a.spare;
+			}
+			a.blocks = nullptr;
+			a.spare = keep;
+			a.last = nullptr;
+			a.cur = a.buffer;
+			a.end = a.buffer + a.buffer_size;
+		}
+
+		//回收全部内存并忘记调用者提供的缓冲区
+		static void release() noexcept {
+			release(local_arena());
+		}
+
+		//当前线程 arena 持有的内存块总量，不含调用者提供的缓冲区
+		static size_t arena_bytes() noexcept {
+			arena& a = local_arena();
+			size_t total = nullptr != a.spare ? a.spare->bytes : 0;
+			for (block* b = a.blocks; nullptr != b; b = b->next) { total += b->bytes; }
+			return total;
+		}
+	};
+
+
+	// 将按字节分配的静态分配器包装成按元素个数分配的标准分配器接口，
+	// 容器通过 allocator_traits 使用它，空类不占用容器空间
+	template <class Tp, class Alloc>
+	class simple_alloc
+	{
+	public:
+		using value_type = Tp;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+
+		using propagate_on_container_move_assignment = std::true_type;
+		using is_always_equal = std::true_type;
+
+		template <class Other>
+		struct rebind {
+			using other = simple_alloc<Other, Alloc>;
+		};
+
+		simple_alloc() noexcept = default;
+
+		template <class Other>
+		simple_alloc(const simple_alloc<Other, Alloc>&) noexcept {}
+
+		Tp* allocate(size_t n) {
+			return 0 == n ? nullptr : static_cast<Tp*>(Alloc::allocate(n * sizeof(Tp)));
+		}
+
+		void deallocate(Tp* p, size_t n) noexcept {
+			if (nullptr != p) { Alloc::deallocate(p, n * sizeof(Tp)); }
+		}
+
+		// 按字节搬移内存块，只能用于可以按字节复制的元素，new_n为0时归还内存
+		Tp* reallocate(Tp* p, size_t old_n, size_t new_n) {
+			if (0 == new_n) {
+				deallocate(p, old_n);
+				return nullptr;
+			}
+			if (nullptr == p) { return allocate(new_n); }
+			return static_cast<Tp*>(Alloc::reallocate(p, old_n * sizeof(Tp), new_n * sizeof(Tp)));
+		}
+	};
+
+	template <class Tp, class Other, class Alloc>
+	inline bool operator==(const simple_alloc<Tp, Alloc>&, const simple_alloc<Other, Alloc>&) noexcept { return true; }
+
+	template <class Tp, class Other, class Alloc>
+	inline bool operator!=(const simple_alloc<Tp, Alloc>&, const simple_alloc<Other, Alloc>&) noexcept { return false; }
+
+}
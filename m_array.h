@@ -195,26 +195,38 @@ namespace mstd {
 		size_type size() const noexcept { return Size; }
 		size_type empty() const noexcept { return Size == 0; }
 
-		reference operator[](size_type index) noexcept {
-			if (index >= Size) throw std::out_of_range{ "index out of range" };
-			return *elems[index];
+		reference operator[](size_type index) noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(index < Size, "array subscript out of range");
+			return elems[index];
 		}
-		const_reference operator[](size_type index) const noexcept {
-			if (index >= Size) throw std::out_of_range{ "index out of range" };
-			return *elems[index];
+		const_reference operator[](size_type index) const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(index < Size, "array subscript out of range");
+			return elems[index];
 		}
-		reference at(size_type index) noexcept {
+		reference at(size_type index) {
 			if (index >= Size) throw std::out_of_range{ "index out of range" };
-			return *elems[index];
+			return elems[index];
 		}
-		const_reference at(size_type index) const noexcept {
+		const_reference at(size_type index) const {
 			if (index >= Size) throw std::out_of_range{ "index out of range" };
-			return *elems[index];
+			return elems[index];
+		}
+		reference front() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(Size != 0, "front() called on empty array");
+			return *elems;
+		}
+		const_reference front() const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(Size != 0, "front() called on empty array");
+			return *elems;
+		}
+		reference back() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(Size != 0, "back() called on empty array");
+			return *(elems + Size - 1);
+		}
+		const_reference back() const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(Size != 0, "back() called on empty array");
+			return *(elems + Size - 1);
 		}
-		reference front() noexcept { return *elems; }
-		const_reference front() const noexcept { return *elems; }
-		reference back() noexcept { return *(elems + Size); }
-		const_reference back() const noexcept { return *(elems + Size); }
 		pointer data() noexcept { return elems; }
 		const_pointer data() const noexcept { return elems; }
 		void fill(const value_type& value) {
@@ -1,81 +1,78 @@
 #pragma once
 
-#include "m_utility.h"			// 
-#include "m_iterator.h"			// reverse_iterator;
-#include "m_memory.h"			// _Tidy_guard;
+#include <initializer_list>		// std::initializer_list;
+#include <stdexcept>			// std::out_of_range; std::length_error;
+#include "m_utility.h"			// move(); move_backward();
+#include "m_iterator.h"			// reverse_iterator; _MSTD_HARDENED_CHECK();
+#include "m_memory.h"			// _Tidy_guard; _Uninitialized_relocate();
+#include "m_algorithm.h"		// equal(); lexicographical_compare(); rotate(); reverse();
+#include "m_memory_resource.h"	// pmr::polymorphic_allocator;
 
 
 namespace mstd {
 
-	template<class Deque_type>
-	struct _Deque_unchecked_const_iterator {
-
-	};
-
-
-
-
-
-	template<class Deque_type>
-	struct _Deque_const_iterator {
+	// 迭代器保存容器数据的地址和元素的逻辑偏移量，解引用时由偏移量求得块号和块内位置
+	// 两端插入不移动元素，偏移量不变，迭代器仍指向原来的元素
+	template<class Deque_val>
+	struct _Deque_const_iterator : _Iterator_base {
 
 		using iterator_category = std::random_access_iterator_tag;
-		using value_type = typename Deque_type::value_type;
-		using size_type = typename Deque_type::size_type;
-		using difference_type = typename Deque_type::difference_type;
-		using pointer = typename Deque_type::const_pointer;
+		using value_type = typename Deque_val::value_type;
+		using size_type = typename Deque_val::size_type;
+		using difference_type = typename Deque_val::difference_type;
+		using pointer = typename Deque_val::const_pointer;
 		using reference = const value_type&;
 
-		static constexpr int block_size = Deque_type::block_size;
-
-		const Deque_type* Mycont_{};
+		const Deque_val* Mycont_{};
 		size_type Myoff_{};
 
-		Deque_type() noexcept = default;
-		Deque_type(const Deque_type* cont_ptr, size_type off) noexcept
-			: Mycont_(cont_ptr), Myoff_(off) {}
+		_Deque_const_iterator() noexcept = default;
+		_Deque_const_iterator(size_type off, const Deque_val* cont) noexcept
+			: Mycont_(cont), Myoff_(off) {}
 
 		reference operator*() const noexcept {
-			size_type block = Mycont_->_Get_block();
-			size_type off = Myoff_ % block_size;
-			return Mycont_->_Get_map()[block][off];
+			_Verify_deref();
+			return *Mycont_->_Address(Myoff_);
 		}
 
 		pointer operator->() const noexcept {
-			size_type block = Mycont_->_Get_block();
-			size_type off = Myoff_ % block_size;
-			return Mycont_->_Get_map()[block] + off;
+			_Verify_deref();
+			return Mycont_->_Address(Myoff_);
+		}
+
+		reference operator[](const difference_type off) const noexcept {
+			return *(*this + off);
 		}
 
-		_Deque_const_iterator& operator++() const noexcept {
+		_Deque_const_iterator& operator++() noexcept {
 			++Myoff_;
 			return *this;
 		}
 
-		_Deque_const_iterator operator++(int) const noexcept {
+		_Deque_const_iterator operator++(int) noexcept {
 			_Deque_const_iterator temp = *this;
 			++Myoff_;
 			return temp;
 		}
 
-		_Deque_const_iterator& operator--() const noexcept {
+		_Deque_const_iterator& operator--() noexcept {
 			--Myoff_;
 			return *this;
 		}
 
-		_Deque_const_iterator operator--(int) const noexcept {
+		_Deque_const_iterator operator--(int) noexcept {
 			_Deque_const_iterator temp = *this;
 			--Myoff_;
 			return temp;
 		}
 
-		_Deque_const_iterator& operator+=(const difference_type off) const noexcept {
-			Myoff_ += off;
+		_Deque_const_iterator& operator+=(const difference_type off) noexcept {
+			Myoff_ += static_cast<size_type>(off);
 			return *this;
 		}
 
-		_Deque_const_iterator& operator-=(const difference_type off) const noexcept {
-			Myoff_ -= off;
+		_Deque_const_iterator& operator-=(const difference_type off) noexcept {
+			Myoff_ -= static_cast<size_type>(off);
 			return *this;
 		}
 
@@ -85,6 +82,11 @@ namespace mstd {
 			return temp;
 		}
 
+		friend _Deque_const_iterator operator+(const difference_type off, _Deque_const_iterator iter) noexcept {
+			iter += off;
+			return iter;
+		}
+
 		_Deque_const_iterator operator-(const difference_type off) const noexcept {
 			_Deque_const_iterator temp = *this;
 			temp -= off;
@@ -92,7 +94,7 @@ namespace mstd {
 		}
 
 		difference_type operator-(const _Deque_const_iterator& right) const noexcept {
-			return static_cast<difference_type>(Myoff_ - right->Myoff_);
+			return static_cast<difference_type>(Myoff_ - right.Myoff_);
 		}
 
 		bool operator==(const _Deque_const_iterator& right) const noexcept {
@@ -108,68 +110,86 @@ namespace mstd {
 		}
 
 		bool operator>(const _Deque_const_iterator& right) const noexcept {
-			return Myoff_ > right.Myoff_;
+			return right < *this;
 		}
 
 		bool operator<=(const _Deque_const_iterator& right) const noexcept {
-			return !(*this > right);
+			return !(right < *this);
 		}
 
 		bool operator>=(const _Deque_const_iterator& right) const noexcept {
 			return !(*this < right);
 		}
 
+		// 分段迭代器接口，copy/fill/find/accumulate 等按块取出连续的指针区间(见 m_iterator.h)
+		pointer _Segment_ptr() const noexcept { return Mycont_->_Address(Myoff_); }
+		size_type _Segment_left() const noexcept { return Deque_val::_Block_size - Myoff_ % Deque_val::_Block_size; }
+
+		void _Verify_deref() const noexcept {
+#if _ITERATOR_DEBUG
+			this->_Verify_current("deque iterator invalidated");
+			_MSTD_VERIFY(Mycont_ && Myoff_ - Mycont_->off_ < Mycont_->size_,
+				"cannot dereference out of range deque iterator");
+#endif // _ITERATOR_DEBUG
+		}
 	};
 
-	template<class Deque_type>
-	struct _Deque_iterator : _Deque_const_iterator<Deque_type> {
+	template<class Deque_val>
+	struct _Deque_iterator : _Deque_const_iterator<Deque_val> {
 
-		using value_type = typename Deque_type::value_type;
-		using size_type = typename Deque_type::size_type;
-		using difference_type = typename Deque_type::difference_type;
-		using pointer = typename Deque_type::pointer;
+		using value_type = typename Deque_val::value_type;
+		using size_type = typename Deque_val::size_type;
+		using difference_type = typename Deque_val::difference_type;
+		using pointer = typename Deque_val::pointer;
 		using reference = value_type&;
 
-		using _MyParent = _Deque_const_iterator<Deque_type>;
+		using _MyParent = _Deque_const_iterator<Deque_val>;
 
-		using _MyParent::_MyParent;  // ʹø캯
+		using _MyParent::_MyParent;  // 使用父辈构造函数
 
 		reference operator*() const noexcept {
 			return const_cast<reference>(_MyParent::operator*());
 		}
 
 		pointer operator->() const noexcept {
-			return const_cast<pointer>(_MyParent::operator->());
+			this->_Verify_deref();
+			return this->Mycont_->_Address(this->Myoff_);
+		}
+
+		reference operator[](const difference_type off) const noexcept {
+			return *(*this + off);
 		}
 
-		_Deque_iterator& operator++() const noexcept {
+		pointer _Segment_ptr() const noexcept { return this->Mycont_->_Address(this->Myoff_); }
+
+		_Deque_iterator& operator++() noexcept {
 			_MyParent::operator++();
 			return *this;
 		}
 
-		_Deque_iterator operator++(int) const noexcept {
+		_Deque_iterator operator++(int) noexcept {
 			_Deque_iterator temp = *this;
 			_MyParent::operator++();
 			return temp;
 		}
 
-		_Deque_iterator& operator--() const noexcept {
+		_Deque_iterator& operator--() noexcept {
 			_MyParent::operator--();
 			return *this;
 		}
 
-		_Deque_iterator operator--(int) const noexcept {
+		_Deque_iterator operator--(int) noexcept {
 			_Deque_iterator temp = *this;
 			_MyParent::operator--();
 			return temp;
 		}
 
-		_Deque_iterator& operator+=(const difference_type off) const noexcept {
+		_Deque_iterator& operator+=(const difference_type off) noexcept {
 			_MyParent::operator+=(off);
 			return *this;
 		}
 
-		_Deque_iterator& operator-=(const difference_type off) const noexcept {
+		_Deque_iterator& operator-=(const difference_type off) noexcept {
 			_MyParent::operator-=(off);
 			return *this;
 		}
@@ -180,6 +200,11 @@ namespace mstd {
 			return temp;
 		}
 
+		friend _Deque_iterator operator+(const difference_type off, _Deque_iterator iter) noexcept {
+			iter += off;
+			return iter;
+		}
+
 		using _MyParent::operator-;
 
 		_Deque_iterator operator-(const difference_type off) const noexcept {
@@ -190,7 +215,7 @@ namespace mstd {
 
 	};
 
-	template <class Value_type, class Size_type, class Difference_type, class Pointer, class Const_pointer, class Reference, class Const_reference, class Mapptr_type>
+	template <class Value_type, class Size_type, class Difference_type, class Pointer, class Const_pointer, class Mapptr_type>
 	struct _Deque_iter_types {
 		using value_type = Value_type;
 		using size_type = Size_type;
@@ -205,8 +230,17 @@ namespace mstd {
 		using _Map_ptr = Tp**;
 	};
 
+	// 每块元素个数取不超过 bytes 字节的最大2的幂，至少16个
+	constexpr size_t _Deque_block_size(const size_t elem_size, const size_t bytes) noexcept {
+		size_t count = 16;
+		while (count * 2 * elem_size <= bytes) {
+			count *= 2;
+		}
+		return count;
+	}
+
 	template<class Val_type>
-	class _Deque_val : public _Container_base_real {  // ̳proxy_/firstiter_ݳԱ
+	class _Deque_val : public _Container_base {  // _ITERATOR_DEBUG 下继承 proxy_ 数据成员
 	public:
 		using value_type = typename Val_type::value_type;
 		using size_type = typename Val_type::size_type;
@@ -217,60 +251,66 @@ namespace mstd {
 		using const_reference = const value_type&;
 		using _Map_ptr = typename Val_type::_Map_ptr;
 
-	private:
-		static constexpr size_type _Bytes = sizeof(value_type);
+		// 内存块按字节定长(4KiB，一个普通页)，块内元素个数为2的幂，求块号和块内位置只需移位和取掩码
+		// 元素超过256字节时每块固定16个元素，避免退化成每块一两个元素的指针数组
+		static constexpr size_type _Block_bytes = 4096;
+		static constexpr size_type _Block_size = _Deque_block_size(sizeof(value_type), _Block_bytes);
 
-	public:
-		static constexpr int _Block_size =
-			_Bytes <= 1 ? 16
-			: _Bytes <= 2 ? 8
-			: _Bytes <= 4 ? 4
-			: _Bytes <= 8 ? 2
-			: 1;
-
-		_Map_ptr map_{};		// ѭͷָ
-		size_type mapsize_{};	// ѭдС
-		size_type off_{};		// һԪͷλõƫ
-		size_type size_{};		// Ԫ
+		_Map_ptr map_{};		// 循环数组，保存各内存块指针
+		size_type mapsize_{};	// 循环数组大小，为0或2的幂
+		size_type off_{};		// 第一个元素的逻辑偏移量，始终小于 mapsize_ * _Block_size
+		size_type size_{};		// 元素总数
 
 		_Deque_val() noexcept = default;
 
-		// ƫΪoffԪڴͷָ ѭбеλ
+		// 求得偏移量为off的元素所处内存块头指针 在循环列表中的位置
 		size_type _Get_block(size_type off) const noexcept { return (off / _Block_size) & (mapsize_ - 1); }
+
+		// 偏移量为off的元素地址
+		pointer _Address(size_type off) const noexcept {
+			return map_[_Get_block(off)] + static_cast<difference_type>(off % _Block_size);
+		}
 	};
 
-	template<class Tp, class Alloc = mstd::allocator<Tp>>
+	// 分段存储的双端队列
+	// 元素存放在定长内存块中，块指针放在大小为2的幂的循环数组 map 中
+	// 两端插入删除均摊 O(1)，不移动已有元素，元素的引用在两端插入后保持有效
+	// 随机访问只需一次除法(移位)和一次取掩码；空出的内存块留在 map 中供后续插入复用，shrink_to_fit() 归还
+	template<class Tp, class Alloc = malloc_allocator<0>>
 	class deque {
 	private:
 		friend _Tidy_guard<deque>;
 
-		using _Alloc_t = _Rebind_alloc_t<Alloc, Tp>;
-		using _Alloc_traits = allocator_traits<_Alloc_t>;
+		// 元素分配器，按字节分配的静态分配器由 simple_alloc 包装
+		using _Alty = _Container_alloc_t<Alloc, Tp>;
+		using _Alty_traits = allocator_traits<_Alty>;
 
-		using _Alloc_ptr_t = _Rebind_alloc_t<Alloc, typename _Alloc_traits::pointer>;
-		using _Alloc_ptr_traits = allocator_traits<_Alloc_ptr_t>;
+		// map 分配器，分配块指针数组
+		using _Alpty = _Rebind_alloc_t<_Alty, typename _Alty_traits::pointer>;
+		using _Alpty_traits = allocator_traits<_Alpty>;
 
-		using _Alloc_proxy_t = _Rebind_alloc_t<Alloc, _Container_proxy>;
-		using _Alloc_proxy_traits = allocator_traits<_Alloc_proxy_t>;
+		using _Map_ptr = typename _Alpty_traits::pointer;
 
-		using _Map_ptr = typename _Alloc_ptr_traits::pointer;
+		using _Internal_val = _Deque_val<conditional_t<_Is_simple_alloc_v<_Alty>, _Deque_simple_types<Tp>,
+			_Deque_iter_types<Tp, typename _Alty_traits::size_type, typename _Alty_traits::difference_type,
+			typename _Alty_traits::pointer, typename _Alty_traits::const_pointer, _Map_ptr>>>;
 
-		using _Internal_val = _Deque_val<conditional_t<_Is_simple_alloc_v<_Alloc_t>, _Deque_simple_types<Tp>, _Deque_iter_types<typename _Alloc_traits::value_type, typename _Alloc_traits::size_type, typename _Alloc_traits::difference_type, typename _Alloc_traits::pointer, typename _Alloc_traits::const_pointer, Tp&, const Tp&, _Map_ptr>>>;
+		static constexpr size_t _Minimum_map_size = 8;
+		static constexpr size_t _Block_size = _Internal_val::_Block_size;
 
-		static constexpr int _Minimum_map_size = 8;
-		static constexpr int _Block_size = _Internal_val::_Block_size;
-
-		// dequeڲݳԱ
-		_Compressed_pair<_Alloc_t, _Internal_val> m_pair_;
+		// 分配器与 map 存放在一起，空分配器不占用空间
+		_Compressed_pair<_Alty, _Internal_val> m_pair_;
 
 	public:
+		static_assert(!mstd::is_const_v<Tp>, "The container element is not allowed to be const type.");
 
 		using data_allocator = Alloc;
+		using allocator_type = _Alty;
 		using value_type = Tp;
-		using size_type = typename _Alloc_traits::size_type;
-		using difference_type = typename _Alloc_traits::difference_type;
-		using pointer = typename _Alloc_traits::pointer;
-		using const_pointer = typename _Alloc_traits::const_pointer;
+		using size_type = typename _Alty_traits::size_type;
+		using difference_type = typename _Alty_traits::difference_type;
+		using pointer = typename _Alty_traits::pointer;
+		using const_pointer = typename _Alty_traits::const_pointer;
 		using reference = value_type&;
 		using const_reference = const value_type&;
 
@@ -279,95 +319,676 @@ namespace mstd {
 		using reverse_iterator = mstd::reverse_iterator<iterator>;
 		using const_reverse_iterator = mstd::reverse_iterator<const_iterator>;
 
-		using _unchecked_const_iterator = _Deque_unchecked_const_iterator<_Internal_val>;
-		using _unchecked_iterator = _Deque_unchecked_iterator<_Internal_val>;
+	public:
+		deque() noexcept(mstd::is_nothrow_default_constructible<_Alty>::value)
+			: m_pair_(_Zero_then_variadic_args_t{}) {}
+
+		explicit deque(const allocator_type& alloc) noexcept
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {}
+
+		explicit deque(size_type count, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			_Tidy_guard<deque> guard{ this };
+			resize(count);
+			guard._Release();
+		}
+
+		deque(size_type count, const value_type& val, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			_Construct_n(count, val);
+		}
+
+		template<class IptIter, mstd::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
+		deque(IptIter first, IptIter last, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			_Construct(first, last);
+		}
+
+		deque(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			_Construct(ilist.begin(), ilist.end());
+		}
+
+		deque(const deque& other)
+			: m_pair_(_One_then_variadic_args_t{}, _Alty_traits::select_on_container_copy_construction(other._Get_alloc())) {
+			_Construct(other._Unchecked_begin(), other._Unchecked_end());
+		}
+
+		deque(const deque& other, const allocator_type& alloc)
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			_Construct(other._Unchecked_begin(), other._Unchecked_end());
+		}
+
+		deque(deque&& other) noexcept
+			: m_pair_(_One_then_variadic_args_t{}, std::move(other._Get_alloc())) {
+			_Swap_data(other);
+		}
+
+		deque(deque&& other, const allocator_type& alloc)
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			if constexpr (!_Alty_traits::is_always_equal::value) {
+				if (_Get_alloc() != other._Get_alloc()) { // 分配器不相等时不能接管对方的内存块，逐个移动元素
+					_Construct(mstd::move_iterator<iterator>(other._Unchecked_begin()),
+						mstd::move_iterator<iterator>(other._Unchecked_end()));
+					return;
+				}
+			}
+			_Swap_data(other);
+		}
+
+		deque& operator=(const deque& other) {
+			if (this == &other) { return *this; }
+			if constexpr (_Choose_pocca_v<_Alty>) {
+				if (_Get_alloc() != other._Get_alloc()) { _Tidy(); }
+			}
+			_Pocca(_Get_alloc(), other._Get_alloc());
+			_Assign_range(other._Unchecked_begin(), other._Unchecked_end());
+			return *this;
+		}
+
+		deque& operator=(deque&& other)
+			noexcept(_Choose_pocma_v<_Alty> != _Pocma_values::_No_propagate_allocators) {
+			if (this == &other) { return *this; }
+			if constexpr (_Choose_pocma_v<_Alty> == _Pocma_values::_No_propagate_allocators) {
+				if (_Get_alloc() != other._Get_alloc()) {
+					_Assign_range(mstd::move_iterator<iterator>(other._Unchecked_begin()),
+						mstd::move_iterator<iterator>(other._Unchecked_end()));
+					return *this;
+				}
+			}
+			_Tidy();
+			_Pocma(_Get_alloc(), other._Get_alloc());
+			_Swap_data(other);
+			return *this;
+		}
+
+		deque& operator=(std::initializer_list<value_type> ilist) {
+			_Assign_range(ilist.begin(), ilist.end());
+			return *this;
+		}
+
+		~deque() { _Tidy(); }
+
+		void assign(size_type count, const value_type& val) {
+			_Orphan_all();
+			size_type idx = 0;
+			for (; idx != _Mysize() && idx != count; ++idx) {
+				*_Address(_Myoff() + idx) = val;
+			}
+			_Erase_back_to(idx);
+			for (; idx != count; ++idx) {
+				_Emplace_back_internal(val);
+			}
+		}
+
+		template<class IptIter, mstd::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
+		void assign(IptIter first, IptIter last) {
+			_Assign_range(first, last);
+		}
+
+		void assign(std::initializer_list<value_type> ilist) {
+			_Assign_range(ilist.begin(), ilist.end());
+		}
+
+		allocator_type get_allocator() const noexcept { return _Get_alloc(); }
 
 	public:
-		deque() : m_pair_(_Zero_then_variadic_args_t{}) {
+		iterator begin() noexcept { return _Make_iter(_Myoff()); }
+		iterator end() noexcept { return _Make_iter(_Myoff() + _Mysize()); }
+		const_iterator begin() const noexcept { return _Make_iter(_Myoff()); }
+		const_iterator end() const noexcept { return _Make_iter(_Myoff() + _Mysize()); }
+		const_iterator cbegin() const noexcept { return begin(); }
+		const_iterator cend() const noexcept { return end(); }
+
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		const_reverse_iterator crend() const noexcept { return rend(); }
+
+		bool empty() const noexcept { return _Mysize() == 0; }
+		size_type size() const noexcept { return _Mysize(); }
+		size_type max_size() const noexcept {
+			const size_type alloc_max = _Alty_traits::max_size(_Get_alloc());
+			const size_type diff_max = static_cast<size_type>(_Max_possible_v<difference_type>);
+			return alloc_max < diff_max ? alloc_max : diff_max;
+		}
+
+		// 归还没有元素的内存块，map 本身保留；没有元素时全部归还
+		void shrink_to_fit() {
+			if (empty()) {
+				_Tidy();
+				return;
+			}
+			const size_type first_block = _Get_block(_Myoff());
+			const size_type used = (_Myoff() % _Block_size + _Mysize() + _Block_size - 1) / _Block_size;
+			for (size_type block = 0; block != _Mapsize(); ++block) {
+				if (((block - first_block) & (_Mapsize() - 1)) >= used && _Map()[block] != nullptr) {
+					_Alty_traits::deallocate(_Get_alloc(), _Map()[block], _Block_size);
+					_Map()[block] = nullptr;
+				}
+			}
+		}
 
+	public:
+		reference operator[](size_type index) noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(index < _Mysize(), "deque subscript out of range");
+			return *_Address(_Myoff() + index);
 		}
 
-		deque(size_type num) {
+		const_reference operator[](size_type index) const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(index < _Mysize(), "deque subscript out of range");
+			return *_Address(_Myoff() + index);
+		}
 
+		reference at(size_type index) {
+			if (index >= _Mysize()) {
+				throw std::out_of_range
+				{ "deque member func at() error: index out of range" };
+			}
+			return *_Address(_Myoff() + index);
 		}
 
-	private:
-		template<class... Args>
-		void _Emplace_back_internal(Args&&... args) {
+		const_reference at(size_type index) const {
+			if (index >= _Mysize()) {
+				throw std::out_of_range
+				{ "deque member func at() error: index out of range" };
+			}
+			return *_Address(_Myoff() + index);
+		}
+
+		reference front() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "front() called on empty deque");
+			return *_Address(_Myoff());
+		}
 
+		const_reference front() const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "front() called on empty deque");
+			return *_Address(_Myoff());
 		}
 
+		reference back() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "back() called on empty deque");
+			return *_Address(_Myoff() + _Mysize() - 1);
+		}
+
+		const_reference back() const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "back() called on empty deque");
+			return *_Address(_Myoff() + _Mysize() - 1);
+		}
+
+	public:
 		template<class... Args>
-		void _Emplace_front_internal(Args&&... args) {
+		reference emplace_back(Args&&... args) {
+			return _Emplace_back_internal(std::forward<Args>(args)...);
+		}
 
+		void push_back(const value_type& val) { _Emplace_back_internal(val); }
+
+		void push_back(value_type&& val) { _Emplace_back_internal(std::move(val)); }
+
+		template<class... Args>
+		reference emplace_front(Args&&... args) {
+			return _Emplace_front_internal(std::forward<Args>(args)...);
 		}
 
-		void _Grow_map(size_type count) {
+		void push_front(const value_type& val) { _Emplace_front_internal(val); }
+
+		void push_front(value_type&& val) { _Emplace_front_internal(std::move(val)); }
 
+		void pop_back() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "pop_back() called on empty deque");
+			_Pop_back_internal();
 		}
 
-		template<class IptIter>
-		void _Construct(IptIter first, IptIter last) {
-			_Tidy_guard guard{ this };
-			for (; first != last; ++first) {
-				_Emplace_back_internal(*first);
+		void pop_front() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "pop_front() called on empty deque");
+			_Pop_front_internal();
+		}
+
+		// 靠近头部时在头部构造再旋转到位，否则在尾部构造，只移动较少一侧的元素
+		template<class... Args>
+		iterator emplace(const_iterator pos, Args&&... args) {
+			const size_type off = _Insert_offset(pos);
+			if (off <= _Mysize() / 2) {
+				_Emplace_front_internal(std::forward<Args>(args)...);
+				if (off != 0) {
+					const iterator first = _Unchecked_begin();
+					mstd::rotate(first, first + 1, first + static_cast<difference_type>(off + 1));
+					_Orphan_all();
+				}
 			}
-			guard._Release();
+			else {
+				_Emplace_back_internal(std::forward<Args>(args)...);
+				if (off != _Mysize() - 1) {
+					const iterator last = _Unchecked_end();
+					mstd::rotate(_Unchecked_begin() + static_cast<difference_type>(off), last - 1, last);
+					_Orphan_all();
+				}
+			}
+			return _Make_iter(_Myoff() + off);
 		}
 
-		void _Construct(size_type count, const value_type& val) {
-			_Tidy_guard guard{ this };
-			for (; count > 0; --count) {
-				_Emplace_back_internal(val);
+		iterator insert(const_iterator pos, const value_type& val) {
+			return emplace(pos, val);
+		}
+
+		iterator insert(const_iterator pos, value_type&& val) {
+			return emplace(pos, std::move(val));
+		}
+
+		iterator insert(const_iterator pos, size_type count, const value_type& val) {
+			const size_type off = _Insert_offset(pos);
+			const size_type old_size = _Mysize();
+			if (off <= old_size / 2) {
+				try {
+					for (size_type i = 0; i != count; ++i) {
+						_Emplace_front_internal(val);
+					}
+				}
+				catch (...) {
+					_Erase_front_to(old_size);
+					throw;
+				}
+				_Rotate_front(count, off);
 			}
-			guard._Release();
+			else {
+				try {
+					for (size_type i = 0; i != count; ++i) {
+						_Emplace_back_internal(val);
+					}
+				}
+				catch (...) {
+					_Erase_back_to(old_size);
+					throw;
+				}
+				_Rotate_back(old_size, off);
+			}
+			return _Make_iter(_Myoff() + off);
+		}
+
+		template<class IptIter, mstd::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
+		iterator insert(const_iterator pos, IptIter first, IptIter last) {
+			const size_type off = _Insert_offset(pos);
+			const size_type old_size = _Mysize();
+			if (off <= old_size / 2) {
+				try {
+					for (; first != last; ++first) {
+						_Emplace_front_internal(*first);
+					}
+				}
+				catch (...) {
+					_Erase_front_to(old_size);
+					throw;
+				}
+				// 逐个放到头部的元素顺序相反
+				const size_type count = _Mysize() - old_size;
+				const iterator ufirst = _Unchecked_begin();
+				mstd::reverse(ufirst, ufirst + static_cast<difference_type>(count));
+				_Rotate_front(count, off);
+			}
+			else {
+				try {
+					for (; first != last; ++first) {
+						_Emplace_back_internal(*first);
+					}
+				}
+				catch (...) {
+					_Erase_back_to(old_size);
+					throw;
+				}
+				_Rotate_back(old_size, off);
+			}
+			return _Make_iter(_Myoff() + off);
 		}
 
+		iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
+			return insert(pos, ilist.begin(), ilist.end());
+		}
 
+		iterator erase(const_iterator pos) noexcept(_MSTD_HARDENING_MODE != 2 && mstd::is_nothrow_move_assignable<value_type>::value) {
+			_MSTD_HARDENED_CHECK(pos.Mycont_ == std::addressof(_Get_data()) && pos.Myoff_ - _Myoff() < _Mysize(),
+				"deque erase iterator outside range");
+			return _Erase_n(pos.Myoff_ - _Myoff(), 1);
+		}
 
+		iterator erase(const_iterator first, const_iterator last) noexcept(_MSTD_HARDENING_MODE != 2 && mstd::is_nothrow_move_assignable<value_type>::value) {
+			_MSTD_HARDENED_CHECK(first.Mycont_ == std::addressof(_Get_data()) && last.Mycont_ == first.Mycont_ &&
+				first.Myoff_ - _Myoff() <= _Mysize() && last.Myoff_ - _Myoff() <= _Mysize() && !(last < first),
+				"deque erase iterator outside range");
+			return _Erase_n(first.Myoff_ - _Myoff(), last.Myoff_ - first.Myoff_);
+		}
 
+		// 只销毁元素，内存块留给之后的插入
+		void clear() noexcept {
+			_Orphan_all();
+			_Destroy_elements();
+			_Mysize() = 0;
+			_Myoff() = 0;
+		}
 
+		void resize(size_type new_sz) {
+			_Erase_back_to(new_sz);
+			while (_Mysize() < new_sz) {
+				_Emplace_back_internal();
+			}
+		}
 
+		void resize(size_type new_sz, const value_type& val) {
+			_Erase_back_to(new_sz);
+			while (_Mysize() < new_sz) {
+				_Emplace_back_internal(val);
+			}
+		}
 
-		_Internal_val& _Get_data() noexcept { return m_pair_.second_; }
+		void swap(deque& other) noexcept {
+			if (this != &other) {
+				_Pocs(_Get_alloc(), other._Get_alloc());
+				_Swap_data(other);
+			}
+		}
 
+	private:
+		_Alty& _Get_alloc() noexcept { return m_pair_._Get_first(); }
+		const _Alty& _Get_alloc() const noexcept { return m_pair_._Get_first(); }
+		_Internal_val& _Get_data() noexcept { return m_pair_.second_; }
 		const _Internal_val& _Get_data() const noexcept { return m_pair_.second_; }
 
-		size_type _Get_block(size_type off) const noexcept { _Get_data()._Get_block(off); }
+		_Map_ptr& _Map() noexcept { return _Get_data().map_; }
+		const _Map_ptr& _Map() const noexcept { return _Get_data().map_; }
+		size_type& _Mapsize() noexcept { return _Get_data().mapsize_; }
+		const size_type& _Mapsize() const noexcept { return _Get_data().mapsize_; }
+		size_type& _Myoff() noexcept { return _Get_data().off_; }
+		const size_type& _Myoff() const noexcept { return _Get_data().off_; }
+		size_type& _Mysize() noexcept { return _Get_data().size_; }
+		const size_type& _Mysize() const noexcept { return _Get_data().size_; }
+
+		size_type _Get_block(size_type off) const noexcept { return _Get_data()._Get_block(off); }
+		pointer _Address(size_type off) const noexcept { return _Get_data()._Address(off); }
 
 		void _Orphan_all() noexcept { _Get_data()._Orphan_all(); }
 
-		Alloc& _Get_alloc() noexcept { _Get_data()._Get_first(); }
-
-		const Alloc& _Get_alloc() const noexcept { _Get_data()._Get_first(); }
+		// 返回给用户的迭代器绑定到本容器，容器内部使用的迭代器不绑定
+		iterator _Make_iter(size_type off) noexcept {
+			iterator iter(off, std::addressof(_Get_data()));
+			iter._Adopt(std::addressof(_Get_data()));
+			return iter;
+		}
+		const_iterator _Make_iter(size_type off) const noexcept {
+			const_iterator iter(off, std::addressof(_Get_data()));
+			iter._Adopt(std::addressof(_Get_data()));
+			return iter;
+		}
 
-		_Map_ptr& _Map() noexcept { return _Get_data().map_; }
+		iterator _Unchecked_begin() noexcept { return iterator(_Myoff(), std::addressof(_Get_data())); }
+		iterator _Unchecked_end() noexcept { return iterator(_Myoff() + _Mysize(), std::addressof(_Get_data())); }
+		const_iterator _Unchecked_begin() const noexcept { return const_iterator(_Myoff(), std::addressof(_Get_data())); }
+		const_iterator _Unchecked_end() const noexcept { return const_iterator(_Myoff() + _Mysize(), std::addressof(_Get_data())); }
 
-		const _Map_ptr& _Map() const noexcept { return _Get_data().map_; }
+		// pos 必须属于本容器且位于 [begin, end]，返回相对 begin 的位置
+		size_type _Insert_offset(const const_iterator& pos) const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(pos.Mycont_ == std::addressof(_Get_data()) && pos.Myoff_ - _Myoff() <= _Mysize(),
+				"deque insert iterator outside range");
+			return pos.Myoff_ - _Myoff();
+		}
 
-		size_type& _Mapsize() noexcept { return _Get_data().mapsize_; }
+		// 尾部新块需要占用 map 中最后一个空位时扩容，保证头尾不会落在同一块上
+		template<class... Args>
+		reference _Emplace_back_internal(Args&&... args) {
+			if ((_Myoff() + _Mysize()) % _Block_size == 0 && _Mapsize() <= (_Mysize() + _Block_size) / _Block_size) {
+				_Grow_map(1);
+			}
+			const size_type new_off = _Myoff() + _Mysize();
+			const pointer ptr = _Block_at(new_off) + static_cast<difference_type>(new_off % _Block_size);
+			_Alty_traits::construct(_Get_alloc(), _Unfancy(ptr), std::forward<Args>(args)...);
+			++_Mysize();
+			return *ptr;
+		}
 
-		const size_type& _Mapsize() const noexcept { return _Get_data().mapsize_; }
+		template<class... Args>
+		reference _Emplace_front_internal(Args&&... args) {
+			if (_Myoff() % _Block_size == 0 && _Mapsize() <= (_Mysize() + _Block_size) / _Block_size) {
+				_Grow_map(1);
+			}
+			// 偏移量为0时绕到 map 末尾，已有元素的偏移量随之改变
+			const size_type new_off = (_Myoff() != 0 ? _Myoff() : _Mapsize() * _Block_size) - 1;
+			const pointer ptr = _Block_at(new_off) + static_cast<difference_type>(new_off % _Block_size);
+			_Alty_traits::construct(_Get_alloc(), _Unfancy(ptr), std::forward<Args>(args)...);
+			if (_Myoff() == 0 && _Mysize() != 0) { _Orphan_all(); }
+			_Myoff() = new_off;
+			++_Mysize();
+			return *ptr;
+		}
 
-		size_type& _Myoff() noexcept { return _Get_data().off_; }
+		void _Pop_back_internal() noexcept {
+			_Alty_traits::destroy(_Get_alloc(), _Unfancy(_Address(_Myoff() + _Mysize() - 1)));
+			if (--_Mysize() == 0) { _Myoff() = 0; }
+		}
 
-		const size_type& _Myoff() const noexcept { return _Get_data().off_; }
+		void _Pop_front_internal() noexcept {
+			_Alty_traits::destroy(_Get_alloc(), _Unfancy(_Address(_Myoff())));
+			if (--_Mysize() == 0) {
+				_Myoff() = 0;
+			}
+			else if (++_Myoff() == _Mapsize() * _Block_size) {
+				_Myoff() = 0;		// 保持 off_ 小于 map 的容量，已有元素的偏移量随之改变
+				_Orphan_all();
+			}
+		}
 
-		size_type& _Mysize() noexcept { return _Get_data().size_; }
+		// 偏移量 off 所在的内存块，没有时分配；空出的块留在 map 中复用
+		pointer _Block_at(size_type off) {
+			pointer& block = _Map()[_Get_block(off)];
+			if (block == nullptr) {
+				block = _Alty_traits::allocate(_Get_alloc(), _Block_size);
+			}
+			return block;
+		}
 
-		const size_type& _Mysize() const noexcept { return _Get_data().size_; }
+		// map 扩大到原来的2倍以上，块指针按 _Uninitialized_relocate 整段搬移
+		// [off_ 所在块, 末尾) 留在原位置，环绕到 map 头部的块接在原末尾之后，元素的偏移量都不变
+		void _Grow_map(size_type count) {
+			const size_type max_map = max_size() / _Block_size;
+			size_type new_size = _Mapsize() > 0 ? _Mapsize() : 1;
+			while (new_size - _Mapsize() < count || new_size < _Minimum_map_size) {
+				if (max_map - new_size < new_size) {
+					throw std::length_error{ "deque too long" };
+				}
+				new_size *= 2;
+			}
+			count = new_size - _Mapsize();	// count >= 原 mapsize_ > 第一个块的位置
+
+			_Alpty almap(_Get_alloc());
+			const size_type block_off = _Myoff() / _Block_size;
+			const _Map_ptr new_map = _Alpty_traits::allocate(almap, new_size);
+			_Map_ptr ptr = new_map + static_cast<difference_type>(block_off);
+			ptr = _Uninitialized_relocate(_Map() + static_cast<difference_type>(block_off),
+				_Map() + static_cast<difference_type>(_Mapsize()), ptr, almap);
+			ptr = _Uninitialized_relocate(_Map(), _Map() + static_cast<difference_type>(block_off), ptr, almap);
+			_Uninitialized_value_construct_n(ptr, count - block_off, almap);
+			_Uninitialized_value_construct_n(new_map, block_off, almap);
+
+			if (_Map() != nullptr) {
+				_Alpty_traits::deallocate(almap, _Map(), _Mapsize());
+			}
+			_Map() = new_map;
+			_Mapsize() = new_size;
+		}
+
+		void _Destroy_elements() noexcept {
+			if constexpr (!is_trivially_destructible<value_type>::value) {
+				size_type off = _Myoff();
+				size_type count = _Mysize();
+				while (count != 0) {	// 按块销毁
+					const size_type in_block = off % _Block_size;
+					const size_type num = count < _Block_size - in_block ? count : _Block_size - in_block;
+					const pointer first = _Map()[_Get_block(off)] + static_cast<difference_type>(in_block);
+					_Destroy_range(first, first + static_cast<difference_type>(num), _Get_alloc());
+					off += num;
+					count -= num;
+				}
+			}
+		}
 
+		// 销毁全部元素并归还内存块和 map
+		void _Tidy() noexcept {
+			_Orphan_all();
+			if (_Map() == nullptr) { return; }
+			_Destroy_elements();
+			for (size_type block = 0; block != _Mapsize(); ++block) {
+				if (_Map()[block] != nullptr) {
+					_Alty_traits::deallocate(_Get_alloc(), _Map()[block], _Block_size);
+				}
+			}
+			_Alpty almap(_Get_alloc());
+			_Alpty_traits::deallocate(almap, _Map(), _Mapsize());
+			_Map() = nullptr;
+			_Mapsize() = _Myoff() = _Mysize() = 0;
+		}
 
+		// 只交换 map 和元素个数，不交换分配器
+		// 迭代器保存的是容器数据的地址，不能跟随元素到另一个容器，交换后全部失效
+		void _Swap_data(deque& other) noexcept {
+			_Orphan_all();
+			other._Orphan_all();
+			mstd::swap(_Map(), other._Map());
+			mstd::swap(_Mapsize(), other._Mapsize());
+			mstd::swap(_Myoff(), other._Myoff());
+			mstd::swap(_Mysize(), other._Mysize());
+		}
 
+		template<class IptIter>
+		void _Construct(IptIter first, IptIter last) {
+			_Tidy_guard<deque> guard{ this };
+			for (; first != last; ++first) {
+				_Emplace_back_internal(*first);
+			}
+			guard._Release();
+		}
 
+		void _Construct_n(size_type count, const value_type& val) {
+			_Tidy_guard<deque> guard{ this };
+			for (; count > 0; --count) {
+				_Emplace_back_internal(val);
+			}
+			guard._Release();
+		}
 
+		// 依次赋值给已有元素，多出的元素删除，不足的在尾部构造，内存块全部复用
+		template<class IptIter>
+		void _Assign_range(IptIter first, IptIter last) {
+			_Orphan_all();
+			size_type idx = 0;
+			for (; idx != _Mysize() && first != last; ++idx, ++first) {
+				*_Address(_Myoff() + idx) = *first;
+			}
+			_Erase_back_to(idx);
+			for (; first != last; ++first) {
+				_Emplace_back_internal(*first);
+			}
+		}
 
+		void _Erase_back_to(size_type new_sz) noexcept {
+			while (_Mysize() > new_sz) {
+				_Pop_back_internal();
+			}
+		}
 
+		void _Erase_front_to(size_type new_sz) noexcept {
+			while (_Mysize() > new_sz) {
+				_Pop_front_internal();
+			}
+		}
 
+		// 头部新插入的 count 个元素旋转到位置 off
+		void _Rotate_front(size_type count, size_type off) {
+			if (off != 0) {
+				const iterator first = _Unchecked_begin();
+				mstd::rotate(first, first + static_cast<difference_type>(count),
+					first + static_cast<difference_type>(count + off));
+				_Orphan_all();
+			}
+		}
 
+		// 尾部 old_size 之后新插入的元素旋转到位置 off
+		void _Rotate_back(size_type old_size, size_type off) {
+			if (off != old_size) {
+				const iterator first = _Unchecked_begin();
+				mstd::rotate(first + static_cast<difference_type>(off), first + static_cast<difference_type>(old_size),
+					_Unchecked_end());
+				_Orphan_all();
+			}
+		}
 
+		// 删除 [off, off + count)，移动前后两段中较短的一段
+		iterator _Erase_n(size_type off, size_type count) {
+			if (count != 0) {
+				const iterator first = _Unchecked_begin();
+				const bool moved = off != 0 && off + count != _Mysize();
+				if (off < _Mysize() - (off + count)) {
+					mstd::move_backward(first, first + static_cast<difference_type>(off),
+						first + static_cast<difference_type>(off + count));
+					for (; count != 0; --count) {
+						_Pop_front_internal();
+					}
+				}
+				else {
+					mstd::move(first + static_cast<difference_type>(off + count), _Unchecked_end(),
+						first + static_cast<difference_type>(off));
+					for (; count != 0; --count) {
+						_Pop_back_internal();
+					}
+				}
+				if (moved) { _Orphan_all(); }
+			}
+			return _Make_iter(_Myoff() + off);
+		}
 
 	};
 
-}
+	template<class Tp, class Alloc>
+	struct is_trivially_relocatable<deque<Tp, Alloc>>
+		: _Container_is_trivially_relocatable<_Container_alloc_t<Alloc, Tp>> {};
+
+	template<class Tp, class Alloc>
+	inline void swap(deque<Tp, Alloc>& left, deque<Tp, Alloc>& right) noexcept {
+		left.swap(right);
+	}
+
+	template<class Tp, class Alloc>
+	inline bool operator==(const deque<Tp, Alloc>& left, const deque<Tp, Alloc>& right) {
+		return left.size() == right.size() && mstd::equal(left.begin(), left.end(), right.begin());
+	}
+
+	template<class Tp, class Alloc>
+	inline bool operator!=(const deque<Tp, Alloc>& left, const deque<Tp, Alloc>& right) {
+		return !(left == right);
+	}
+
+	template<class Tp, class Alloc>
+	inline bool operator<(const deque<Tp, Alloc>& left, const deque<Tp, Alloc>& right) {
+		return mstd::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end());
+	}
+
+	template<class Tp, class Alloc>
+	inline bool operator>(const deque<Tp, Alloc>& left, const deque<Tp, Alloc>& right) {
+		return right < left;
+	}
+
+	template<class Tp, class Alloc>
+	inline bool operator<=(const deque<Tp, Alloc>& left, const deque<Tp, Alloc>& right) {
+		return !(right < left);
+	}
+
+	template<class Tp, class Alloc>
+	inline bool operator>=(const deque<Tp, Alloc>& left, const deque<Tp, Alloc>& right) {
+		return !(left < right);
+	}
+
+	namespace pmr {
+		template<class Tp>
+		using deque = mstd::deque<Tp, polymorphic_allocator<Tp>>;
+	}
 
+}
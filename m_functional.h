@@ -74,7 +74,7 @@ namespace mstd {
 	// Operator classes :
 	// Operator classes are classes that define functional objects that call operators :
 	// 
-	// º
+	// 算术类仿函数
 	template<typename Tp = void>
 	struct plus;
 
@@ -86,7 +86,7 @@ namespace mstd {
 	};
 
 	template<>
-	struct plus<void> {  // plus<>{} Ĭģ operator()ᷢƵûbinary_functiontypedefԱ
+	struct plus<void> {  // plus<>{} 默认模板参数 调用operator()会发生参数推导，没有binary_function里面的typedef成员
 		template<typename Tp, typename Up>
 		auto operator()(Tp&& left, Up&& right) const
 			noexcept(noexcept(std::forward<Tp>(left) + std::forward<Up>(right)))
@@ -152,7 +152,7 @@ namespace mstd {
 		}
 	};
 
-	// ϵº
+	// 关系类仿函数
 	template<typename Tp>
 	struct equal_to : public binary_function<Tp, Tp, bool> {
 		bool operator()(const Tp& left, const Tp& right) const {
@@ -195,7 +195,7 @@ namespace mstd {
 		}
 	};
 
-	// ߼º
+	// 逻辑运算类仿函数
 	template<typename Tp>
 	struct logical_and : public binary_function<Tp, Tp, bool> {
 		bool operator()(const Tp& left, const Tp& right) const {
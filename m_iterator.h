@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <string>
 #include <iostream>
+#include <stdexcept>
+#include <iterator>		// std::random_access_iterator_tag;
 
 #include "m_type_traits.h"
 
@@ -46,7 +48,7 @@ namespace mstd {
 	template<class Tp>
 	struct iterator_traits<Tp*> : _Iterator_traits_pointer_base<Tp> {};
 
-	// жǷǵ _Is_iterator_v
+	// 判断是否是迭代器 _Is_iterator_v
 	template<typename Iter, typename = void>
 	constexpr bool _Is_iterator_v = false;
 
@@ -86,7 +88,7 @@ namespace mstd {
 	template<class Iter>
 	constexpr bool _Is_ranges_rdm_iter_v = mstd::is_convertible<_Iter_category_t<Iter>, mstd::random_access_iterator_tag>::value;
 
-	//  _MSTD_VERIFY()
+	// 定义 _MSTD_VERIFY()
 
 	inline void _Verify_fail(const char* mesg, const char* file, int line) {
 		std::string error_mesg = std::string("Verify fail: ") + mesg + ", at file " + file + " in line " + std::to_string(line) + ".";
@@ -101,10 +103,41 @@ namespace mstd {
 		}													\
 	} while (false)
 
-#define _ITERATOR_DEBUG 1
+	// 定义 _MSTD_HARDENING_MODE，决定 operator[]、front()/back() 与迭代器位置的检查方式，at() 始终抛出异常
+	// 0 : 不检查，release 下没有额外开销
+	// 1 : 检查失败时由 _MSTD_VERIFY 终止程序
+	// 2 : 检查失败时抛出 std::out_of_range
+
+#ifndef _MSTD_HARDENING_MODE
+#ifdef NDEBUG
+#define _MSTD_HARDENING_MODE 0
+#else
+#define _MSTD_HARDENING_MODE 1
+#endif
+#endif // _MSTD_HARDENING_MODE
+
+#if _MSTD_HARDENING_MODE == 0
+#define _MSTD_HARDENED_CHECK(cond, mesg) ((void)0)
+#elif _MSTD_HARDENING_MODE == 1
+#define _MSTD_HARDENED_CHECK(cond, mesg) _MSTD_VERIFY(cond, mesg)
+#else
+#define _MSTD_HARDENED_CHECK(cond, mesg)					\
+	do {													\
+		if (!(cond)) {										\
+			throw std::out_of_range{ mesg };				\
+		}													\
+	} while (false)
+#endif
+
+	// 定义 _ITERATOR_DEBUG，非0时 vector/list/deque 的迭代器检查是否已经失效(见 m_memory.h)
+	// 默认关闭，关闭时迭代器不含任何额外成员；可在包含头文件前定义为1开启
+
+#ifndef _ITERATOR_DEBUG
+#define _ITERATOR_DEBUG 0
+#endif
 
 #if _ITERATOR_DEBUG
-	// ָƫػ
+	// 指针迭代器偏特化
 	template<class Tp>
 	constexpr void _Verify_range(const Tp* const first, const Tp* const last) noexcept {
 		_MSTD_VERIFY(first < last, "transposed pointer range");
@@ -115,22 +148,22 @@ namespace mstd {
 	template<class Iter, class = void>
 	constexpr bool _Allow_inheriting_unwrap_v = false;
 
-	//   _Prevent_inheriting_unwarpis_same_v<>ֹ̳ԵĿɽװ
+	// 容器迭代器 定义 _Prevent_inheriting_unwarp，is_same_v<>防止继承性的可解包装
 	template<class Iter>
 	constexpr bool _Allow_inheriting_unwrap_v<Iter, void_t<typename Iter::_Prevent_inheriting_unwrap>> = mstd::is_same_v<Iter, typename Iter::_Prevent_inheriting_unwrap>;
 
 	template<class Iter, class Sentinel = Iter, class = void>
 	constexpr bool _Range_verifiable_v = false;
 
-	template<class Iter, class Sentinel>	// ඨһ Sentinel  
+	template<class Iter, class Sentinel>	// 多定义一个 Sentinel 类型 ？
 	constexpr bool _Range_verifiable_v<Iter, Sentinel, void_t<decltype(_Verify_range(mstd::declval<const Iter&>(), mstd::declval<const Sentinel&>()))>> = _Allow_inheriting_unwrap_v<Iter>;
 
-	// ADL(Argument Dependent Lookup) ?
+	// ADL(Argument Dependent Lookup) 参数依赖查找?
 
 	template<class Iter, class Sentinel>
 	inline constexpr void _Mstd_adl_verify_range(const Iter& first, const Sentinel& last) {
 		if constexpr (_Range_verifiable_v<Iter, Sentinel>) {
-			_Verify_range(first, last);	 // õ_Verify_range()Ԫغ
+			_Verify_range(first, last);	 // 会调用迭代器定义的_Verify_range()友元重载函数
 		}
 	}
 
@@ -207,7 +240,7 @@ namespace mstd {
 		if constexpr (is_pointer_v<Iter>)
 			return iter + 0;
 		else if constexpr (_Unwrappable_for_offset_v<Iter> && is_integral_v<Diff>) {
-			// зΧ˲
+			// 进行范围核查
 			using Iter_diff = _Iter_difference_t<_Remove_cvref_t<Iter>>;
 			using Commom_diff = common_type_t<Iter_diff, Diff>;
 
@@ -241,6 +274,38 @@ namespace mstd {
 		}
 	}
 
+	// 可以 O(1) 求距离和跳转的迭代器，标准库和 vector/deque 的迭代器使用 std 的标签
+	template<class Iter>
+	constexpr bool _Is_any_rdm_iter_v = _Is_ranges_rdm_iter_v<Iter> ||
+		mstd::is_convertible<_Iter_category_t<Iter>, std::random_access_iterator_tag>::value;
+
+	// 分段迭代器：元素分块连续存放(如 deque)，迭代器提供
+	//   _Segment_ptr()  : 当前元素的地址
+	//   _Segment_left() : 当前块内从当前元素起剩余的元素个数
+	// copy/move/fill/find/accumulate 按块取出指针区间，每块走指针的 memmove/memset 快速路径
+	template<class Iter, class = void>
+	constexpr bool _Is_segmented_iter_v = false;
+
+	template<class Iter>
+	constexpr bool _Is_segmented_iter_v<Iter, void_t<decltype(mstd::declval<const Iter&>()._Segment_ptr()),
+		decltype(mstd::declval<const Iter&>()._Segment_left())>> = true;
+
+	// 依次对 [first, first + count) 的每个连续块调用 func(ptr, num)
+	// func 返回本块处理的元素个数，小于 num 时停止；返回处理的元素总数
+	template<class SegIter, class Func>
+	inline size_t _Visit_segments(SegIter first, const size_t count, Func func) {
+		size_t done = 0;
+		while (done != count) {
+			const size_t left = static_cast<size_t>(first._Segment_left());
+			const size_t num = count - done < left ? count - done : left;
+			const size_t used = func(first._Segment_ptr(), num);
+			done += used;
+			if (used != num) { break; }
+			first += static_cast<_Iter_difference_t<SegIter>>(num);
+		}
+		return done;
+	}
+
 	template<class IptIter, class Diff>
 	constexpr void advance(IptIter& iter, const Diff off) {
 		if constexpr (_Is_ranges_rdm_iter_v<IptIter>) {
@@ -272,14 +337,14 @@ namespace mstd {
 	template<class IptIter>
 	constexpr _Iter_difference_t<IptIter> distance(IptIter first, IptIter last) {
 		if constexpr (_Is_ranges_rdm_iter_v<IptIter>) {
-			return last - first;	// Լ鷶ΧǷϷ
+			return last - first;	// 迭代器需自己定义检查范围是否合法
 		}
 		else {
 			_Mstd_adl_verify_range(first, last);
 
 			auto ufirst = _Get_unwrapped_iter(first);
 			const auto ulast = _Get_unwrapped_iter(last);
-			_Iter_category_t<IptIter> off = 0;
+			_Iter_difference_t<IptIter> off = 0;
 			for (; ufirst != ulast; ++ufirst) {
 				++off;
 			}
@@ -325,7 +390,7 @@ namespace mstd {
 		friend class reverse_iterator;
 
 		constexpr reverse_iterator() = default;
-		constexpr explicit reverse_iterator(BidIter iter) // ݲ쳣 ǷӰnoexcept?
+		constexpr explicit reverse_iterator(BidIter iter) // 传递参数异常 是否影响noexcept?
 			noexcept(mstd::is_nothrow_move_constructible<BidIter>::value)
 			: base_iter_(mstd::move(iter)) {}
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "m_alloc.h"		// malloc_allocator;
+#include "m_memory.h"		// allocator_traits; _Compressed_pair;
+#include "m_memory_resource.h"	// pmr::polymorphic_allocator;
 #include "m_iterator.h"		// reverse_iterator;
 #include "m_constructor.h"	// construct(); destroy();
 #include "m_algorithm.h"	// equal(); lexicographical_compare();
@@ -14,7 +16,7 @@
 namespace mstd {
 
 	template<class ListType>
-	struct _list_const_iterator {
+	struct _list_const_iterator : _Iterator_base {
 
 		using iterator_category = std::bidirectional_iterator_tag;
 		using value_type = typename ListType::value_type;
@@ -28,12 +30,17 @@ namespace mstd {
 
 		_list_const_iterator() noexcept = default;
 		_list_const_iterator(_Node_ptr ptr) noexcept : ptr_(ptr) {}
+		_list_const_iterator(_Node_ptr ptr, const _Container_base* cont) noexcept : ptr_(ptr) {
+			this->_Adopt(cont);
+		}
 
 		reference operator*() const noexcept {
+			_Verify_deref();
 			return ptr_->data_;
 		}
 
 		pointer operator->() const noexcept {
+			_Verify_deref();
 			return std::addressof(ptr_->data_);
 		}
 
@@ -68,6 +75,18 @@ namespace mstd {
 		}
 
 		_Node_ptr raw_ptr() const noexcept { return ptr_; }
+
+		// _ITERATOR_DEBUG 下检查容器没有被清空或销毁，并且不是 end()
+		// 单独删除一个节点不会使其他迭代器失效，无法在O(1)内发现指向已删除节点的迭代器
+		void _Verify_deref() const noexcept {
+#if _ITERATOR_DEBUG
+			this->_Verify_current("list iterator invalidated");
+			if (const auto cont = this->_Getcont()) {
+				const auto& data = static_cast<const typename ListType::_Scary_val&>(*cont);
+				_MSTD_VERIFY(ptr_ != data.head_, "cannot dereference end list iterator");
+			}
+#endif // _ITERATOR_DEBUG
+		}
 	};
 
 	template<class ListType>
@@ -79,6 +98,8 @@ namespace mstd {
 
 		using _list_const_iterator<ListType>::_list_const_iterator;
 
+		_list_iterator(const Parent& right) noexcept : Parent(right) {}
+
 		reference operator*() const noexcept {
 			return const_cast<reference>(Parent::operator*());
 		}
@@ -113,10 +134,11 @@ namespace mstd {
 
 	template<class Tp, class Alloc>
 	struct _list_node {
-		using data_allocator = Alloc;
 		using value_type = Tp;
 		using size_type = size_t;
 		using _Node_ptr = _list_node*;
+		using _Alnode = _Rebind_alloc_t<Alloc, _list_node>;
+		using _Alnode_traits = allocator_traits<_Alnode>;
 
 		_Node_ptr prev_{};
 		_Node_ptr next_{};
@@ -124,34 +146,39 @@ namespace mstd {
 
 		_list_node() = default;
 
-		static _Node_ptr get_node() {
-			return static_cast<_Node_ptr>
-				(data_allocator::allocate(sizeof(_list_node)));
+		static _Node_ptr get_node(_Alnode& al) {
+			return _Unfancy(_Alnode_traits::allocate(al, 1));
 		}
 
-		static void put_node(_Node_ptr ptr) noexcept {
-			data_allocator::deallocate(ptr, sizeof(_list_node));
+		static void put_node(_Alnode& al, _Node_ptr ptr) noexcept {
+			_Alnode_traits::deallocate(al, ptr, 1);
 		}
 
 		template<class... Args>
-		static _Node_ptr create_node(Args&&...args) {
-			_Node_ptr ptr = get_node();
-			mstd::construct(&(ptr->data_), std::forward<Args>(args)...);
+		static _Node_ptr create_node(_Alnode& al, Args&&...args) {
+			_Node_ptr ptr = get_node(al);
+			try {
+				_Alnode_traits::construct(al, std::addressof(ptr->data_), std::forward<Args>(args)...);
+			}
+			catch (...) {
+				put_node(al, ptr);
+				throw;
+			}
 			return ptr;
 		}
 
-		static void delete_node(_Node_ptr ptr) noexcept {
-			mstd::destroy(std::addressof(ptr->data_));
-			put_node(ptr);
+		static void delete_node(_Alnode& al, _Node_ptr ptr) noexcept {
+			_Alnode_traits::destroy(al, std::addressof(ptr->data_));
+			put_node(al, ptr);
 		}
 
-		static void delete_nodes_non_head(_Node_ptr head) noexcept {
+		static void delete_nodes_non_head(_Alnode& al, _Node_ptr head) noexcept {
 			if (head == nullptr) return;
 			_Node_ptr node{ head->next_ };
 			_Node_ptr temp{};
 			while (node != head) {
 				temp = node->next_;
-				delete_node(node);
+				delete_node(al, node);
 				node = temp;
 			}
 		}
@@ -165,7 +192,7 @@ namespace mstd {
 			return node;
 		}
 
-		// [first,last)ڵ뵽posλǰ
+		// 将[first,last)节点插入到pos位置前面
 		static void transfer(_Node_ptr pos, _Node_ptr first, _Node_ptr last) noexcept {
 			_Node_ptr pos_prev = pos->prev_;
 			_Node_ptr first_prev = first->prev_;
@@ -177,49 +204,173 @@ namespace mstd {
 			last->prev_ = first_prev;
 		}
 
-		static void delete_range(_Node_ptr first, _Node_ptr last) noexcept {
+		static void delete_range(_Alnode& al, _Node_ptr first, _Node_ptr last) noexcept {
 			_Node_ptr prev = first->prev_;
 			_Node_ptr next{};
-			size_type del_size{};
 			for (; first != last;) {
 				next = first->next_;
-				delete_node(first);
+				delete_node(al, first);
 				first = next;
 			}
 			prev->next_ = last;
 			last->prev_ = prev;
 		}
 
+		// 合并相邻的有序区间[first, mid)和[mid, last)，只修改链接，返回合并后的第一个节点
+		// 后半段的元素严格小于前半段的元素时才移到前面，相等元素保持原有顺序
 		template<class Binary_Pred>
 		static _Node_ptr _sort_merge(_Node_ptr first, _Node_ptr mid,
 			_Node_ptr last, Binary_Pred pred) {
+			if (first == mid || mid == last || !pred(mid->data_, mid->prev_->data_)) {
+				return first;	// 两段已经有序
+			}
+			const _Node_ptr new_first = pred(mid->data_, first->data_) ? mid : first;
+			for (;;) {
+				if (pred(mid->data_, first->data_)) {
+					// 后半段中所有小于 *first 的连续节点一次移到 first 前面
+					_Node_ptr run_end = mid->next_;
+					while (run_end != last && pred(run_end->data_, first->data_)) {
+						run_end = run_end->next_;
+					}
+					transfer(first, mid, run_end);
+					mid = run_end;
+					if (mid == last) { return new_first; }
+				}
+				else {
+					first = first->next_;
+					if (first == mid) { return new_first; }
+				}
+			}
+		}
 
+		// 自底向上的归并排序：像二进制计数器一样维护长度为2的幂的有序段，
+		// 相邻两段长度相等时立即合并，合并总是发生在刚访问过的节点上；不递归，不分配内存
+		template<class Binary_Pred>
+		static void sort_by_merge(_Node_ptr head, Binary_Pred pred) {
+			constexpr size_t max_runs = sizeof(size_type) * 8 + 1;
+			_Node_ptr run_first[max_runs];
+			size_type run_size[max_runs];
+			size_t runs = 0;
+			_Node_ptr cur = head->next_;
+			while (cur != head) {
+				run_first[runs] = cur;
+				run_size[runs] = 1;
+				++runs;
+				cur = cur->next_;
+				while (runs >= 2 && run_size[runs - 2] == run_size[runs - 1]) {
+					run_first[runs - 2] = _sort_merge(run_first[runs - 2], run_first[runs - 1], cur, pred);
+					run_size[runs - 2] *= 2;
+					--runs;
+				}
+			}
+			for (; runs >= 2; --runs) {
+				run_first[runs - 2] = _sort_merge(run_first[runs - 2], run_first[runs - 1], head, pred);
+			}
+		}
+
+		// 元素较小且可以按字节复制时，把元素和节点指针复制到连续的缓冲区中排序，再按顺序重新链接节点。
+		// 比较在连续内存上进行，避免大链表归并时逐个节点的缓存未命中；节点本身不移动，迭代器仍指向原来的元素
+		struct _Sort_entry {
+			value_type val_;
+			_Node_ptr node_;
+		};
+
+		static constexpr bool _Sort_by_copy_v = mstd::is_trivially_copyable<value_type>::value &&
+			sizeof(value_type) <= 2 * sizeof(void*);
+
+		// 约 8 个元素以下两种方式耗时相当，直接归并省去缓冲区分配(见 main.cpp 中的 bench_list_sorts)
+		static constexpr size_type _Sort_by_copy_min = 16;
 
-			return first;
+		// 对 [buf, buf + n) 稳定排序，tmp 为同样大小的缓冲区，返回排好序的那块缓冲区。
+		// 先对每 _Sort_run 个元素插入排序，再自底向上两两归并，在 buf 与 tmp 之间交替。
+		// 不使用 std::stable_sort：_Sort_entry 属于 mstd，std 算法内部按 ADL 查找 swap 时与 mstd::swap 有歧义
+		static constexpr size_type _Sort_run = 32;
+
+		template<class Binary_Pred>
+		static _Sort_entry* sort_entries(_Sort_entry* buf, _Sort_entry* tmp, size_type n, Binary_Pred& pred) {
+			for (size_type lo = 0; lo < n; lo += _Sort_run) {
+				const size_type hi = n - lo > _Sort_run ? lo + _Sort_run : n;
+				for (size_type i = lo + 1; i < hi; ++i) {
+					const _Sort_entry cur = buf[i];
+					size_type j = i;
+					for (; j > lo && pred(cur.val_, buf[j - 1].val_); --j) {
+						buf[j] = buf[j - 1];
+					}
+					buf[j] = cur;
+				}
+			}
+			_Sort_entry* src = buf;
+			_Sort_entry* dst = tmp;
+			for (size_type width = _Sort_run; width < n; width *= 2) {
+				for (size_type lo = 0; lo < n; lo += 2 * width) {
+					const size_type mid = n - lo > width ? lo + width : n;
+					const size_type hi = n - mid > width ? mid + width : n;
+					size_type i = lo, j = mid, k = lo;
+					while (i != mid && j != hi) {
+						dst[k++] = pred(src[j].val_, src[i].val_) ? src[j++] : src[i++];
+					}
+					for (; i != mid; ++i) { dst[k++] = src[i]; }
+					for (; j != hi; ++j) { dst[k++] = src[j]; }
+				}
+				_Sort_entry* const done = dst;
+				dst = src;
+				src = done;
+			}
+			return src;
 		}
 
+		// 缓冲区分配失败时返回 false，链表保持不变；比较抛出异常时链表同样保持不变
 		template<class Binary_Pred>
-		static _Node_ptr sort_impl(_Node_ptr& first, size_type sz, Binary_Pred pred) {
-			if (sz == 0) {
-				return first;
+		static bool sort_by_copy(_Alnode& al, _Node_ptr head, size_type sz, Binary_Pred pred) {
+			using _Alentry = _Rebind_alloc_t<_Alnode, _Sort_entry>;
+			using _Alentry_traits = allocator_traits<_Alentry>;
+			_Alentry entry_al(al);
+			_Sort_entry* buf = nullptr;
+			try {
+				buf = _Unfancy(_Alentry_traits::allocate(entry_al, 2 * sz));
 			}
-			else if (sz == 1) {
-				return first->next_;
+			catch (...) {
+				return false;
 			}
-			auto mid = sort_impl(first, sz / 2, pred);
-			const auto last = sort_impl(mid, sz - sz / 2, pred);
-			first = _sort_merge(first, mid, last, pred);
-			return last;
+
+			_Node_ptr node = head->next_;
+			for (size_type i = 0; i < sz; ++i, node = node->next_) {
+				::new (static_cast<void*>(buf + i)) _Sort_entry{ node->data_, node };
+			}
+			_Sort_entry* sorted = nullptr;
+			try {
+				sorted = sort_entries(buf, buf + sz, sz, pred);
+			}
+			catch (...) {
+				_Alentry_traits::deallocate(entry_al, buf, 2 * sz);
+				throw;
+			}
+
+			_Node_ptr prev = head;
+			for (size_type i = 0; i < sz; ++i) {
+				prev->next_ = sorted[i].node_;
+				sorted[i].node_->prev_ = prev;
+				prev = sorted[i].node_;
+			}
+			prev->next_ = head;
+			head->prev_ = prev;
+			_Alentry_traits::deallocate(entry_al, buf, 2 * sz);
+			return true;
 		}
 
 	};
 
 	template<class Tp, class Alloc = malloc_allocator<0>>
 	class list {
+	private:
+		// 元素分配器，按字节分配的静态分配器由 simple_alloc 包装
+		using _Alty = _Container_alloc_t<Alloc, Tp>;
+
 	public:
 		static_assert(!mstd::is_const_v<Tp>, "The container element is not allowed to be const type.");
 
 		using data_allocator = Alloc;
+		using allocator_type = _Alty;
 		using value_type = Tp;
 		using pointer = value_type*;
 		using reference = value_type&;
@@ -233,24 +384,50 @@ namespace mstd {
 		using reverse_iterator = mstd::reverse_iterator<iterator>;
 		using const_reverse_iterator = mstd::reverse_iterator<const_iterator>;
 
-		using _Node = _list_node<Tp, Alloc>;
+		using _Node = _list_node<Tp, _Alty>;
 		using _Node_ptr = _Node*;
+		using _Alnode = typename _Node::_Alnode;
+		using _Alnode_traits = allocator_traits<_Alnode>;
+
+		static_assert(mstd::is_same_v<typename _Alnode_traits::pointer, _Node_ptr>,
+			"list does not support allocators with fancy pointers.");
 
 	protected:
+		struct _List_val : _Container_base {
+			_Node_ptr head_{};
+			size_type size_{};
+		};
+
+		// 节点分配器与头节点存放在一起，空分配器不占用空间
+		_Compressed_pair<_Alnode, _List_val> m_pair_;
+
+	public:
+		using _Scary_val = _List_val;	// 供迭代器检查是否指向头节点
+
+	protected:
+
+		_Alnode& _Get_alloc() noexcept { return m_pair_._Get_first(); }
+		const _Alnode& _Get_alloc() const noexcept { return m_pair_._Get_first(); }
+		_List_val& _Get_data() noexcept { return m_pair_.second_; }
+		const _List_val& _Get_data() const noexcept { return m_pair_.second_; }
 
-		_Node_ptr head_{};
-		size_type size_{};
+		_Node_ptr& _Myhead() noexcept { return m_pair_.second_.head_; }
+		const _Node_ptr& _Myhead() const noexcept { return m_pair_.second_.head_; }
+		size_type& _Mysize() noexcept { return m_pair_.second_.size_; }
+		const size_type& _Mysize() const noexcept { return m_pair_.second_.size_; }
 
-		void empty_init() noexcept {
-			head_->next_ = head_;
-			head_->prev_ = head_;
+		// 分配头节点，构造函数调用
+		void empty_init() {
+			_Myhead() = _Node::get_node(_Get_alloc());
+			_Myhead()->next_ = _Myhead();
+			_Myhead()->prev_ = _Myhead();
 		}
 
 		template<class... Args>
 		void alloc_node_and_link(_Node_ptr pos, size_type num, Args&&... args) {
 			_Node_ptr ptr{};
 			for (; num > 0; --num) {
-				ptr = _Node::create_node(std::forward<Args>(args)...); // ܽж std::move(value_type())
+				ptr = _Node::create_node(_Get_alloc(), std::forward<Args>(args)...); // 不能进行多次 std::move(value_type())；
 				pos = _Node::link_node(pos, ptr);
 			}
 		}
@@ -259,14 +436,31 @@ namespace mstd {
 		void alloc_node_and_link(_Node_ptr pos, IptIter first, IptIter last) {
 			_Node_ptr ptr{};
 			for (; first != last; ++first) {
-				ptr = _Node::create_node(*first);
+				ptr = _Node::create_node(_Get_alloc(), *first);
 				pos = _Node::link_node(pos, ptr);
 			}
 		}
 
+		// 只交换头节点和元素个数，不交换分配器，迭代器随节点一起交换
 		void exchange(list& other) noexcept {
-			mstd::swap(other.head_, this->head_);
-			mstd::swap(other.size_, this->size_);
+			mstd::swap(other._Myhead(), this->_Myhead());
+			mstd::swap(other._Mysize(), this->_Mysize());
+			_Get_data()._Swap_proxy_and_iterators(other._Get_data());
+		}
+
+		// 返回给用户的迭代器绑定到本容器，_ITERATOR_DEBUG 为0时与原始指针相同
+		iterator _Make_iter(_Node_ptr ptr) noexcept { return iterator(ptr, std::addressof(_Get_data())); }
+		const_iterator _Make_iter(_Node_ptr ptr) const noexcept { return const_iterator(ptr, std::addressof(_Get_data())); }
+
+		// 释放全部节点以及头节点
+		void _Tidy() noexcept {
+			_Get_data()._Orphan_all();
+			if (_Myhead() != nullptr) {
+				_Node::delete_nodes_non_head(_Get_alloc(), _Myhead());
+				_Node::put_node(_Get_alloc(), _Myhead());
+				_Myhead() = nullptr;
+				_Mysize() = 0;
+			}
 		}
 
 		bool is_invalid_iterator(const_iterator pos) noexcept {
@@ -274,46 +468,102 @@ namespace mstd {
 		}
 
 	public:
-		list() : head_(_Node::get_node()) { empty_init(); }
-		explicit list(size_type num) : head_(_Node::get_node()), size_(num) {
+		list() : m_pair_(_Zero_then_variadic_args_t{}) { empty_init(); }
+		explicit list(const allocator_type& alloc) : m_pair_(_One_then_variadic_args_t{}, alloc) { empty_init(); }
+		explicit list(size_type num, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
 			empty_init();
-			alloc_node_and_link(head_, num);
+			alloc_node_and_link(_Myhead(), num);
+			_Mysize() = num;
 		}
-		list(size_type num, const value_type& val) : head_(_Node::get_node()), size_(num) {
+		list(size_type num, const value_type& val, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
 			empty_init();
-			alloc_node_and_link(head_, num, val);
+			alloc_node_and_link(_Myhead(), num, val);
+			_Mysize() = num;
 		}
 
 		template<class IptIter, mstd::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
-		list(IptIter first, IptIter last) : head_(_Node::get_node()), size_(std::distance(first, last)) {
+		list(IptIter first, IptIter last, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			empty_init();
+			alloc_node_and_link(_Myhead(), first, last);
+			_Mysize() = std::distance(first, last);
+		}
+		list(std::initializer_list<Tp> ilist, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
 			empty_init();
-			alloc_node_and_link(head_, first, last);
+			alloc_node_and_link(_Myhead(), ilist.begin(), ilist.end());
+			_Mysize() = ilist.size();
 		}
-		list(std::initializer_list<Tp> ilist) : head_(_Node::get_node()), size_(ilist.size()) {
+		list(const list& other)
+			: m_pair_(_One_then_variadic_args_t{}, _Alnode_traits::select_on_container_copy_construction(other._Get_alloc())) {
 			empty_init();
-			alloc_node_and_link(head_, ilist.begin(), ilist.end());
+			alloc_node_and_link(_Myhead(), other.cbegin(), other.cend());
+			_Mysize() = other.size();
 		}
-		list(const list& other) : head_(_Node::get_node()), size_(other.size()) {
+		list(const list& other, const allocator_type& alloc)
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
 			empty_init();
-			alloc_node_and_link(head_, other.cbegin(), other.cend());
+			alloc_node_and_link(_Myhead(), other.cbegin(), other.cend());
+			_Mysize() = other.size();
 		}
 
 		list& operator=(const list& other) {
 			if (this != &other) {
-				list temp{ other };
-				this->swap(temp);
+				if constexpr (_Choose_pocca_v<_Alnode>) {
+					if (_Get_alloc() != other._Get_alloc()) { // 头节点需要由新的分配器重新分配
+						_Tidy();
+						_Pocca(_Get_alloc(), other._Get_alloc());
+						empty_init();
+					}
+				}
+				else {
+					_Pocca(_Get_alloc(), other._Get_alloc());
+				}
+				list temp(other, allocator_type(_Get_alloc()));
+				exchange(temp);
 			}
 			return *this;
 		}
-		list(list&& other) noexcept : head_(_Node::get_node()) {
+		list(list&& other) : m_pair_(_One_then_variadic_args_t{}, std::move(other._Get_alloc())) {
 			empty_init();
 			exchange(other);
 		}
-		list& operator=(list&& other) noexcept {
-			if (this != &other) {
-				clear();
-				exchange(other);
+		list(list&& other, const allocator_type& alloc) : m_pair_(_One_then_variadic_args_t{}, alloc) {
+			empty_init();
+			if constexpr (!_Alnode_traits::is_always_equal::value) {
+				if (_Get_alloc() != other._Get_alloc()) { // 分配器不相等时不能接管对方的节点，逐个移动元素
+					for (auto iter = other.begin(); iter != other.end(); ++iter) {
+						emplace_back(std::move(*iter));
+					}
+					return;
+				}
 			}
+			exchange(other);
+		}
+		list& operator=(list&& other)
+			noexcept(_Choose_pocma_v<_Alnode> != _Pocma_values::_No_propagate_allocators) {
+			if (this == &other) { return *this; }
+			if constexpr (_Choose_pocma_v<_Alnode> == _Pocma_values::_No_propagate_allocators) {
+				if (_Get_alloc() != other._Get_alloc()) {
+					list temp(std::move(other), allocator_type(_Get_alloc()));
+					exchange(temp);
+					return *this;
+				}
+			}
+			if constexpr (_Choose_pocma_v<_Alnode> == _Pocma_values::_Propagate_allocators) {
+				if (_Get_alloc() != other._Get_alloc()) { // 头节点由旧分配器分配，归还后用新的分配器重新分配
+					_Tidy();
+					_Pocma(_Get_alloc(), other._Get_alloc());
+					empty_init();
+					exchange(other);
+					return *this;
+				}
+			}
+			clear();
+			_Pocma(_Get_alloc(), other._Get_alloc());
+			exchange(other);
 			return *this;
 		}
 
@@ -322,54 +572,50 @@ namespace mstd {
 			return *this;
 		}
 
-		~list() {
-			if (head_ != nullptr) {
-				_Node::delete_nodes_non_head(head_);
-				_Node::put_node(head_);
-				head_ = nullptr;
-			}
-		}
+		~list() { _Tidy(); }
+
+		allocator_type get_allocator() const noexcept { return allocator_type(_Get_alloc()); }
 
 	public:
-		iterator begin() noexcept { return iterator(head_->next_); }
-		const_iterator begin() const noexcept { return const_iterator(head_->next_); }
-		iterator end() noexcept { return iterator(head_); }
-		const_iterator end() const noexcept { return const_iterator(head_); }
-		const_iterator cbegin() const noexcept { return const_iterator(head_->next_); }
-		const_iterator cend() const noexcept { return const_iterator(head_); }
+		iterator begin() noexcept { return _Make_iter(_Myhead()->next_); }
+		const_iterator begin() const noexcept { return _Make_iter(_Myhead()->next_); }
+		iterator end() noexcept { return _Make_iter(_Myhead()); }
+		const_iterator end() const noexcept { return _Make_iter(_Myhead()); }
+		const_iterator cbegin() const noexcept { return _Make_iter(_Myhead()->next_); }
+		const_iterator cend() const noexcept { return _Make_iter(_Myhead()); }
 		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
 		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
 		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
 		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
 
-		bool empty() const noexcept { return size_ == 0; }
-		size_type size() const noexcept { return size_; }
+		bool empty() const noexcept { return _Mysize() == 0; }
+		size_type size() const noexcept { return _Mysize(); }
 
 		reference front() noexcept {
-			return head_->next_->data_;
+			return _Myhead()->next_->data_;
 		}
 
 		const_reference front() const noexcept {
-			return head_->next_->data_;
+			return _Myhead()->next_->data_;
 		}
 
 		reference back() noexcept {
-			return head_->prev_->data_;
+			return _Myhead()->prev_->data_;
 		}
 
 		const_reference back() const noexcept {
-			return head_->prev_->data_;
+			return _Myhead()->prev_->data_;
 		}
 
 		template<class IptIter, std::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
 		void assign(IptIter first, IptIter last) {
-			list temp(first, last);
-			this->swap(temp);
+			list temp(first, last, allocator_type(_Get_alloc()));
+			exchange(temp);
 		}
 
 		void assign(size_type num, const value_type& val) {
-			list temp(num, val);
-			this->swap(temp);
+			list temp(num, val, allocator_type(_Get_alloc()));
+			exchange(temp);
 		}
 
 		void assign(std::initializer_list<value_type> ilist) {
@@ -379,7 +625,7 @@ namespace mstd {
 		template<class... Args>
 		void emplace(const_iterator pos, Args&&... args) {
 			alloc_node_and_link((--pos).raw_ptr(), 1, std::forward<Args>(args)...);
-			++size_;
+			++_Mysize();
 		}
 
 		template<class... Args>
@@ -401,63 +647,63 @@ namespace mstd {
 		}
 
 		void pop_front() noexcept {
-			_Node::delete_range(head_->next_, head_->next_->next_);
-			--size_;
+			_Node::delete_range(_Get_alloc(), _Myhead()->next_, _Myhead()->next_->next_);
+			--_Mysize();
 		}
 
 		void pop_back() noexcept {
-			_Node::delete_range(head_->prev_, head_);
-			--size_;
+			_Node::delete_range(_Get_alloc(), _Myhead()->prev_, _Myhead());
+			--_Mysize();
 		}
 
 		void erase(const_iterator pos) noexcept {
 			_Node_ptr ptr = pos.raw_ptr();
-			_Node::delete_range(ptr, ptr->next_);
-			--size_;
+			_Node::delete_range(_Get_alloc(), ptr, ptr->next_);
+			--_Mysize();
 		}
 
 		void erase(const_iterator first, const_iterator last) noexcept {
 			_Node_ptr fptr = first.raw_ptr();
 			_Node_ptr lptr = last.raw_ptr();
 			auto sz = std::distance(first, last);
-			_Node::delete_range(fptr, lptr);
-			size_ -= sz;
+			_Node::delete_range(_Get_alloc(), fptr, lptr);
+			_Mysize() -= sz;
 		}
 
 		iterator insert(const_iterator pos, const value_type& val) {
 			_Node_ptr ptr = (--pos).raw_ptr();
 			alloc_node_and_link(ptr, 1, val);
-			++size_;
-			return iterator(ptr->next_);
+			++_Mysize();
+			return _Make_iter(ptr->next_);
 		}
 
 		iterator insert(const_iterator pos, size_type num, const value_type& val) {
 			_Node_ptr ptr = (--pos).raw_ptr();
 			alloc_node_and_link(ptr, num, val);
-			size_ += num;
-			return iterator(ptr->next_);
+			_Mysize() += num;
+			return _Make_iter(ptr->next_);
 		}
 
 		template<class IptIter, std::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
 		iterator insert(const_iterator pos, IptIter first, IptIter last) {
 			_Node_ptr ptr = (--pos).raw_ptr();
 			alloc_node_and_link(ptr, first, last);
-			size_ += std::distance(first, last);
-			return iterator(ptr->next_);
+			_Mysize() += std::distance(first, last);
+			return _Make_iter(ptr->next_);
 		}
 
 		iterator insert(const_iterator pos, value_type&& val) {
 			_Node_ptr ptr = (--pos).raw_ptr();
 			alloc_node_and_link(ptr, 1, std::move(val));
-			++size_;
-			return iterator(ptr->next_);
+			++_Mysize();
+			return _Make_iter(ptr->next_);
 		}
 
 		iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
 			_Node_ptr ptr = (--pos).raw_ptr();
 			alloc_node_and_link(ptr, ilist.begin(), ilist.end());
-			size_ += ilist.size();
-			return iterator(ptr->next_);
+			_Mysize() += ilist.size();
+			return _Make_iter(ptr->next_);
 		}
 
 		void resize(size_type num) {
@@ -465,11 +711,11 @@ namespace mstd {
 				alloc_node_and_link((--end()).raw_ptr(), num - size());
 			}
 			else {
-				_Node_ptr ptr{ head_->next_ };
+				_Node_ptr ptr{ _Myhead()->next_ };
 				for (; num > 0; --num, ptr = ptr->next_);
-				_Node::delete_range(ptr, head_);
+				_Node::delete_range(_Get_alloc(), ptr, _Myhead());
 			}
-			size_ = num;
+			_Mysize() = num;
 		}
 
 		void resize(size_type num, const value_type& val) {
@@ -477,22 +723,24 @@ namespace mstd {
 				alloc_node_and_link((--end()).raw_ptr(), num - size(), val);
 			}
 			else {
-				_Node_ptr ptr{ head_->next_ };
+				_Node_ptr ptr{ _Myhead()->next_ };
 				for (; num > 0; --num, ptr = ptr->next_);
-				_Node::delete_range(ptr, head_);
+				_Node::delete_range(_Get_alloc(), ptr, _Myhead());
 			}
-			size_ = num;
+			_Mysize() = num;
 		}
 
 		void clear() noexcept {
-			_Node::delete_range(head_->next_, head_);
-			size_ = 0;
+			_Get_data()._Orphan_all();
+			_Node::delete_range(_Get_alloc(), _Myhead()->next_, _Myhead());
+			_Mysize() = 0;
 		}
 
+		// propagate_on_container_swap 为 false 时只交换节点，分配器不相等时行为未定义
 		void swap(list& right) noexcept {
 			if (this != &right) {
-				mstd::swap(head_, right.head_);
-				mstd::swap(size_, right.size_);
+				_Pocs(_Get_alloc(), right._Get_alloc());
+				exchange(right);
 			}
 		}
 
@@ -509,8 +757,8 @@ namespace mstd {
 
 		void splice(const_iterator pos, list& other) noexcept {
 			_Node::transfer(pos.raw_ptr(), other.begin().raw_ptr(), other.end().raw_ptr());
-			size_ += other.size_;
-			other.size_ = 0;
+			_Mysize() += other._Mysize();
+			other._Mysize() = 0;
 		}
 
 		void splice(const_iterator pos, list&& other) noexcept {
@@ -521,8 +769,8 @@ namespace mstd {
 			const_iterator other_pos) noexcept {
 			_Node::transfer(pos.raw_ptr(), other_pos.raw_ptr(),
 				other_pos.raw_ptr()->next_);
-			++size_;
-			--other.size_;
+			++_Mysize();
+			--other._Mysize();
 		}
 
 		void splice(const_iterator pos, list&& other,
@@ -534,8 +782,8 @@ namespace mstd {
 			const_iterator first, const_iterator last) noexcept {
 			_Node::transfer(pos.raw_ptr(), first.raw_ptr(), last.raw_ptr());
 			auto sz = std::distance(first, last);
-			size_ += sz;
-			other.size_ -= sz;
+			_Mysize() += sz;
+			other._Mysize() -= sz;
 		}
 
 		void splice(const_iterator pos, list&& other,
@@ -549,15 +797,15 @@ namespace mstd {
 
 		template<class Pred>
 		void remove_if(Pred pred) {
-			_Node_ptr begin_ptr = head_->next_;
+			_Node_ptr begin_ptr = _Myhead()->next_;
 			_Node_ptr temp{};
-			while (begin_ptr != head_) {
+			while (begin_ptr != _Myhead()) {
 				temp = begin_ptr->next_;
 				if (pred(begin_ptr->data_)) {
 					begin_ptr->prev_->next_ = begin_ptr->next_;
 					begin_ptr->next_->prev_ = begin_ptr->prev_;
-					_Node::delete_node(begin_ptr);
-					--size_;
+					_Node::delete_node(_Get_alloc(), begin_ptr);
+					--_Mysize();
 				}
 				begin_ptr = temp;
 			}
@@ -569,15 +817,15 @@ namespace mstd {
 
 		template<class Binary_Pred>
 		void unique(Binary_Pred pred) {
-			if (size_ > 1) {
-				_Node_ptr prev = head_->next_;
-				_Node_ptr curr = head_->next_->next_;
-				while (curr != head_) {
+			if (_Mysize() > 1) {
+				_Node_ptr prev = _Myhead()->next_;
+				_Node_ptr curr = _Myhead()->next_->next_;
+				while (curr != _Myhead()) {
 					if (pred(curr->data_, prev->data_)) {
 						prev->prev_->next_ = curr;
 						curr->prev_ = prev->prev_;
-						_Node::delete_node(prev);
-						--size_;
+						_Node::delete_node(_Get_alloc(), prev);
+						--_Mysize();
 					}
 					prev = curr;
 					curr = curr->next_;
@@ -591,23 +839,23 @@ namespace mstd {
 
 		template<class Compare>
 		void merge(list& other, Compare Cmp) {
-			_Node_ptr this_ptr = head_->next_;
-			_Node_ptr other_ptr = other.head_->next_;
+			_Node_ptr this_ptr = _Myhead()->next_;
+			_Node_ptr other_ptr = other._Myhead()->next_;
 			_Node_ptr temp{};
-			while (this_ptr != head_ && other_ptr != other.head_) {
+			while (this_ptr != _Myhead() && other_ptr != other._Myhead()) {
 				if (Cmp(this_ptr->data_, other_ptr->data_)) {
 					temp = other_ptr->next_;
 					_Node::transfer(this_ptr, other_ptr, temp);
-					++size_; --other.size_;
+					++_Mysize(); --other._Mysize();
 					other_ptr = temp;
 				}
 				else {
 					this_ptr = this_ptr->next_;
 				}
 			}
-			if (other_ptr != other.head_) {
-				_Node::transfer(this_ptr, other_ptr, other.head_);
-				++size_; --other.size_;
+			if (other_ptr != other._Myhead()) {
+				_Node::transfer(this_ptr, other_ptr, other._Myhead());
+				++_Mysize(); --other._Mysize();
 			}
 		}
 
@@ -615,14 +863,21 @@ namespace mstd {
 			sort(std::less<>{});
 		}
 
+		// 稳定排序，只重新链接节点，迭代器仍然有效
 		template<class Compare>
 		void sort(Compare Cmp) {
-			_Node_ptr ptr = head_->next_;
-			_Node::sort_impl(ptr, size_, Cmp);
+			if (_Mysize() < 2) { return; }
+			if constexpr (_Node::_Sort_by_copy_v) {
+				if (_Mysize() >= _Node::_Sort_by_copy_min &&
+					_Node::sort_by_copy(_Get_alloc(), _Myhead(), _Mysize(), Cmp)) {
+					return;
+				}
+			}
+			_Node::sort_by_merge(_Myhead(), Cmp);
 		}
 
 		void reverse() noexcept {
-			const _Node_ptr phead = head_;
+			const _Node_ptr phead = _Myhead();
 			_Node_ptr pnode = phead;
 			for (;;) {
 				const _Node_ptr pnext = pnode->next_;
@@ -679,4 +934,14 @@ namespace mstd {
 		return !(left < right);
 	}
 
+	// 头节点分配在堆上，节点不会指回 list 对象本身
+	template<class Tp, class Alloc>
+	struct is_trivially_relocatable<list<Tp, Alloc>>
+		: _Container_is_trivially_relocatable<typename list<Tp, Alloc>::_Alnode> {};
+
+	namespace pmr {
+		template<class Tp>
+		using list = mstd::list<Tp, polymorphic_allocator<Tp>>;
+	}
+
 }
\ No newline at end of file
@@ -1,16 +1,19 @@
 #pragma once
 
 #include <exception>		// std::bad_alloc;
+#include <cstring>			// std::memcpy();
+#include <memory>			// std::unique_ptr; std::shared_ptr;
 
 #include "m_type_traits.h"	// is_trivially_destructible<>;
 #include "m_utility.h"		// pointer_traits;
+#include "m_alloc.h"		// simple_alloc;
 
 
 namespace mstd {
 
 	// C++11 memory
 
-	// װ operator newoperator delete ʵڴ亯
+	// 包装 operator new、operator delete 实现内存分配函数
 	struct _Default_allocate_traits {
 		static void* _Allocate(const size_t bytes) {
 			return ::operator new(bytes);
@@ -88,7 +91,7 @@ namespace mstd {
 		}
 	}
 
-	// װ palcement new
+	// 包装 palcement new
 	template<class Tp, class... Args>
 	inline void _Construct_in_place(Tp& obj, Args&&... args) noexcept(mstd::is_nothrow_constructible<Tp, Args...>::value) {
 		::new (_Voidify_iter(std::addressof(obj))) Tp(mstd::forward<Args>(args)...);
@@ -100,7 +103,7 @@ namespace mstd {
 	}
 
 
-	// ʵ allocator; allocator_traits; 
+	// 实现 allocator; allocator_traits; 
 
 	template<class Alloc, class = void>
 	struct _Get_pointer_type {
@@ -173,7 +176,7 @@ namespace mstd {
 	};
 
 	template<class Alloc>
-	struct _Get_propagate_on_container_copy<Alloc, void_t<typename Alloc::propagate_on_container_on_copy_assignment>> {
+	struct _Get_propagate_on_container_copy<Alloc, void_t<typename Alloc::propagate_on_container_copy_assignment>> {
 		using type = typename Alloc::propagate_on_container_copy_assignment;
 	};
 
@@ -226,7 +229,7 @@ namespace mstd {
 	template<class Tp>
 	struct _Is_default_allocator<allocator<Tp>, void_t<typename allocator<Tp>::_From_primary>> : mstd::is_same<allocator<Tp>, typename allocator<Tp>::_From_primary>::type {};
 
-	// жûǷغ
+	// 判断用户定义分配器是否定义了相关函数
 	template<class Void, class... Args>
 	struct _Has_no_alloc_construct : true_type {};
 
@@ -255,7 +258,21 @@ namespace mstd {
 	struct _Has_max_size : false_type {};
 
 	template<class Alloc>
-	struct _Has_max_size<Alloc, void_t<decltype(mstd::declval<Alloc&>.max_size())>> : true_type {};
+	struct _Has_max_size<Alloc, void_t<decltype(mstd::declval<Alloc&>().max_size())>> : true_type {};
+
+	// 分配器是否提供 reallocate(p, old_n, new_n)，可由底层的 realloc/mremap 原地扩展
+	template<class Alloc, class Size_type, class Pointer, class = void>
+	struct _Has_reallocate : false_type {};
+
+	template<class Alloc, class Size_type, class Pointer>
+	struct _Has_reallocate<Alloc, Size_type, Pointer, void_t<decltype(mstd::declval<Alloc&>().reallocate(mstd::declval<Pointer>(), mstd::declval<Size_type>(), mstd::declval<Size_type>()))>> : true_type {};
+
+	// 按字节分配的静态分配器是否能给出内存块实际可用的大小，见 malloc_allocator::expand_to_usable
+	template<class Alloc, class = void>
+	struct _Has_usable_size : false_type {};
+
+	template<class Alloc>
+	struct _Has_usable_size<Alloc, void_t<decltype(Alloc::expand_to_usable(mstd::declval<void*>(), mstd::declval<size_t>()))>> : true_type {};
 
 	template<class Alloc, class = void>
 	struct _Has_select_on_container_copy_construction : false_type {};
@@ -266,7 +283,7 @@ namespace mstd {
 	template<class Alloc>
 	struct allocator_traits;
 
-	// ȡ
+	// 分配器萃取器
 	template<class Alloc>
 	struct _Normal_allocator_traits { // can be used for all allocators
 
@@ -349,7 +366,7 @@ namespace mstd {
 
 	};
 
-	// ĬϷȡ
+	// 默认分配器的萃取器
 	template<class Alloc>
 	struct _Default_allocator_traits {	// traits for allocator<Tp>;
 
@@ -406,7 +423,7 @@ namespace mstd {
 	template<class Alloc>
 	struct allocator_traits : conditional_t<_Is_default_allocator<Alloc>::value, _Default_allocator_traits<Alloc>, _Normal_allocator_traits<Alloc>> {};
 
-	// ׼ĬϷ
+	// 标准默认分配器
 	template<class Tp>
 	class allocator {
 	public:
@@ -472,13 +489,27 @@ namespace mstd {
 	template <class Alloc, class Value_type>
 	using _Rebind_alloc_t = typename allocator_traits<Alloc>::template rebind_alloc<Value_type>;
 
+	// 容器的元素分配器：标准接口的分配器 rebind 到 Tp，按字节分配的静态分配器(malloc_allocator等)用 simple_alloc 包装
+	template<class Alloc, class Tp, class = void>
+	struct _Get_container_alloc {
+		using type = simple_alloc<Tp, Alloc>;
+	};
+
+	template<class Alloc, class Tp>
+	struct _Get_container_alloc<Alloc, Tp, void_t<typename Alloc::value_type>> {
+		using type = _Rebind_alloc_t<Alloc, Tp>;
+	};
+
+	template<class Alloc, class Tp>
+	using _Container_alloc_t = typename _Get_container_alloc<Alloc, Tp>::type;
+
 	template <class Alloc>
 	constexpr bool _Is_simple_alloc_v = is_same_v<typename allocator_traits<Alloc>::size_type, size_t> &&
 		is_same_v<typename allocator_traits<Alloc>::difference_type, ptrdiff_t> &&
 		is_same_v<typename allocator_traits<Alloc>::pointer, typename Alloc::value_type*> &&
 		is_same_v<typename allocator_traits<Alloc>::const_pointer, const typename Alloc::value_type*>;
 
-	// _Is_simple_alloc_v<Alloc> = true £ԱΪ_Simple_types
+	// _Is_simple_alloc_v<Alloc> = true 条件下，容器成员类型为_Simple_types
 	template <class Value_type>
 	struct _Simple_types {
 		using value_type = Value_type;
@@ -488,18 +519,18 @@ namespace mstd {
 		using const_pointer = const value_type*;
 	};
 
-	// жϷֵԪصļ
+	// 判断分配器拷贝赋值元素的兼容性
 	template <class Alloc>
 	constexpr bool _Choose_pocca_v = allocator_traits<Alloc>::propagate_on_container_copy_assignment::value
 		&& !allocator_traits<Alloc>::is_always_equal::value;
 
 	enum class _Pocma_values {
-		_Equal_allocators, // ƶԪأǽallocator<Tp>
-		_Propagate_allocators, // ֵͨƶԪ
-		_No_propagate_allocators, // ݣƶתΪ
+		_Equal_allocators, // 可以移动元素，甚至是交换，allocator<Tp>
+		_Propagate_allocators, // 通常分配器可以增值，可以移动元素
+		_No_propagate_allocators, // 分配器不兼容，将移动转换为拷贝
 	};
 
-	// жϷƶֵԪصļ
+	// 判断分配器移动赋值元素的兼容性
 	template <class Alloc>
 	constexpr _Pocma_values
 		_Choose_pocma_v = allocator_traits<Alloc>::is_always_equal::value
@@ -596,11 +627,11 @@ namespace mstd {
 	struct _Tidy_guard {
 		Container* cont_;
 
-		void _Release() const noexcept {
+		void _Release() noexcept {
 			cont_ = nullptr;
 		}
 		~_Tidy_guard() {
-			if (cont_) cont_->_Tidy();  // ContainerҪ_Tidy()
+			if (cont_) cont_->_Tidy();  // Container需要定义_Tidy()函数
 		}
 	};
 
@@ -608,10 +639,10 @@ namespace mstd {
 	struct _Tidy_deallocate_guard {
 		Container* cont_;
 
-		void _Release() const noexcept {
+		void _Release() noexcept {
 			cont_ = nullptr;
 		}
-		// ContainerҪ_Tidy_deallocate()
+		// Container需要定义_Tidy_deallocate()函数
 		~_Tidy_deallocate_guard() {
 			if (cont_) cont_->_Tidy_deallocate();
 		}
@@ -788,6 +819,41 @@ namespace mstd {
 		return backout._Release();
 	}
 
+	// 将[first, last)搬到dest开始的未初始化内存，并结束原对象的生命期
+	// 可平凡重定位的类型整体 memcpy，否则逐个构造再销毁原对象。与 move_if_noexcept 相同，
+	// 移动构造可能抛出且可以复制时改为复制，抛出异常时原区间不变；只能抛出异常地移动时原区间的元素可能已被移走
+	template<class Alloc>
+	inline _Alloc_ptr_t<Alloc> _Uninitialized_relocate(_Alloc_ptr_t<Alloc> first, _Alloc_ptr_t<Alloc> last, _Alloc_ptr_t<Alloc> dest, Alloc& alloc) {
+		using Tp = typename Alloc::value_type;
+		if constexpr (is_trivially_relocatable_v<Tp>) {
+			const auto count = static_cast<size_t>(last - first);
+			if (count != 0) {
+				std::memcpy(static_cast<void*>(_Unfancy(dest)), static_cast<const void*>(_Unfancy(first)), count * sizeof(Tp));
+			}
+			return dest + count;
+		}
+		else if constexpr (!is_nothrow_move_constructible<Tp>::value && is_copy_constructible<Tp>::value) {
+			auto result = _Uninitialized_copy(first, last, dest, alloc);
+			_Destroy_range(first, last, alloc);
+			return result;
+		}
+		else {
+			auto result = _Uninitialized_move(first, last, dest, alloc);
+			_Destroy_range(first, last, alloc);
+			return result;
+		}
+	}
+
+	// 标准库中只保存指针的句柄类型
+	template<class Tp>
+	struct is_trivially_relocatable<std::unique_ptr<Tp>> : true_type {};
+
+	template<class Tp>
+	struct is_trivially_relocatable<std::shared_ptr<Tp>> : true_type {};
+
+	template<class Tp>
+	struct is_trivially_relocatable<std::weak_ptr<Tp>> : true_type {};
+
 	template<class Alloc>
 	inline _Alloc_ptr_t<Alloc> _Uninitialized_fill_n(_Alloc_ptr_t<Alloc> first, _Alloc_size_t<Alloc> count, const typename Alloc::value_type& val, Alloc& alloc) {
 		using Tp = typename Alloc::value_type;
@@ -808,21 +874,60 @@ namespace mstd {
 		return backout._Release();
 	}
 
-	// ʵ ITERATOR_DEBUG µ˲
-	struct _Fake_allocator {};
+	// 值初始化count个元素，标量类型直接清零
+	template<class Alloc>
+	inline _Alloc_ptr_t<Alloc> _Uninitialized_value_construct_n(_Alloc_ptr_t<Alloc> first, _Alloc_size_t<Alloc> count, Alloc& alloc) {
+		using Tp = typename Alloc::value_type;
+		if constexpr (_Fill_zero_memset_is_safe<Tp*, Tp> && _Uses_default_construct<Alloc, Tp*>::value) {
+			_Fill_zero_memset(_Unfancy(first), static_cast<size_t>(count));
+			return first + count;
+		}
+		else {
+			_Uninitialized_backout_alloc<Alloc> backout{ first,alloc };
+			for (; count > 0; --count) {
+				backout._Emplace_back();
+			}
+			return backout._Release();
+		}
+	}
+
+	// 默认初始化count个元素，平凡类型不写内存，留给调用者覆盖
+	// 分配器自定义了 construct 时仍交给分配器，与值初始化相同
+	template<class Alloc>
+	inline _Alloc_ptr_t<Alloc> _Uninitialized_default_construct_n(_Alloc_ptr_t<Alloc> first, _Alloc_size_t<Alloc> count, Alloc& alloc) {
+		using Tp = typename Alloc::value_type;
+		if constexpr (!_Uses_default_construct<Alloc, Tp*>::value) {
+			return _Uninitialized_value_construct_n(first, count, alloc);
+		}
+		else if constexpr (is_trivially_default_constructible<Tp>::value) {
+			return first + count;
+		}
+		else {
+			_Uninitialized_backout<Tp*> backout{ _Unfancy(first) };
+			for (auto n = count; n > 0; --n, ++backout.last_) {
+				_Default_construct_in_place(*backout.last_);
+			}
+			backout._Release();
+			return first + count;
+		}
+	}
+
+	// 实现 ITERATOR_DEBUG 下迭代器核查器
+	// 容器持有一个 _Container_proxy，迭代器创建时记下 proxy 和当时的代数 generation_
+	// 容器使迭代器失效时只需把代数加一(O(1))，不需要遍历记录所有迭代器的链表
+	// proxy 带引用计数，容器析构后仍存在的迭代器也能发现容器已经销毁
 
 	struct _Container_base_fake {
 		void _Orphan_all() noexcept {}
 		void _Swap_proxy_and_iterators(_Container_base_fake&) noexcept {}
-		void _Alloc_proxy(const _Fake_allocator&) noexcept {}
-		void _Reload_proxy(const _Fake_allocator&, const _Fake_allocator&) noexcept {}
 	};
 
 	struct _Iterator_base_fake {
 		void _Adopt(const void*) noexcept {}
-		const _Iterator_base_fake* _Getcont() const noexcept {
+		const _Container_base_fake* _Getcont() const noexcept {
 			return nullptr;
 		}
+		void _Verify_current(const char*) const noexcept {}
 
 		static constexpr bool _Unwrap_when_unverified = true;
 	};
@@ -831,187 +936,119 @@ namespace mstd {
 
 	struct _Container_proxy {
 		_Container_proxy() noexcept = default;
-		_Container_proxy(_Container_base_real* cont) noexcept : cont_(cont) {}
+		_Container_proxy(const _Container_base_real* cont) noexcept : cont_(cont) {}
+
+		const _Container_base_real* cont_ = nullptr;	// 容器销毁后置空
+		size_t generation_ = 0;							// 每次使迭代器失效加一
+		std::atomic<size_t> refs_{ 1 };				// 容器本身占一个引用
 
-		const _Container_base_real* cont_ = nullptr;
-		mutable _Iterator_base_real* firstiter_ = nullptr;
+		void _Retain() noexcept { refs_.fetch_add(1, std::memory_order_relaxed); }
+		void _Release() noexcept {
+			if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) { delete this; }
+		}
 	};
 
 	struct _Container_base_real {
 	public:
-		_Container_proxy* proxy_ = nullptr;
+		mutable _Container_proxy* proxy_ = nullptr;	// 第一次创建迭代器时才分配
 
 		_Container_base_real() noexcept = default;
 		_Container_base_real(const _Container_base_real&) = delete;
 		_Container_base_real& operator=(const _Container_base_real&) = delete;
 
-		// ·ڴʱʧЧоɵʧЧ
-		void _Orphan_all() noexcept;
-
-		// ʱҪԼбָ
-		void _Swap_proxy_and_iterators(_Container_base_real& right) noexcept;
+		~_Container_base_real() noexcept {
+			if (proxy_) {
+				proxy_->cont_ = nullptr;
+				proxy_->_Release();
+			}
+		}
 
-		template <class Alloc>
-		void _Alloc_proxy(Alloc&& alloc) {
-			_Container_proxy* const new_proxy = _Unfancy(alloc.allocate(1));
-			_Construct_in_place(*new_proxy, this);
-			proxy_ = new_proxy;
-			new_proxy->proxy_ = this;
+		// 重新分配内存或清空时，使所有旧迭代器失效
+		void _Orphan_all() noexcept {
+			if (proxy_) { ++proxy_->generation_; }
 		}
 
-		template <class Alloc>
-		void _Reload_proxy(Alloc&& old_alloc, Alloc&& new_alloc) {
-			_Container_proxy* const new_proxy = _Unfancy(new_alloc.allocate(1));
-			_Construct_in_place(*new_proxy, this);
-			new_proxy->cont_ = this;
-			_Delete_plain_internal(old_alloc, mstd::exchange(proxy_, new_proxy));
+		// 交换或接管元素时，迭代器跟随元素到另一个容器，交换 proxy 并修正其中的容器指针
+		void _Swap_proxy_and_iterators(_Container_base_real& right) noexcept {
+			_Container_proxy* temp = proxy_;
+			proxy_ = right.proxy_;
+			right.proxy_ = temp;
+			if (proxy_) { proxy_->cont_ = this; }
+			if (right.proxy_) { right.proxy_->cont_ = &right; }
 		}
 
+		// 分配失败时返回 nullptr，迭代器不做检查
+		_Container_proxy* _Get_proxy() const noexcept {
+			if (!proxy_) { proxy_ = new (std::nothrow) _Container_proxy(this); }
+			return proxy_;
+		}
 	};
 
 	struct _Iterator_base_real {
 	public:
-		mutable _Container_proxy* proxy_ = nullptr;
-		mutable _Iterator_base_real* nextiter_ = nullptr;
+		_Container_proxy* proxy_ = nullptr;
+		size_t generation_ = 0;
 
 		_Iterator_base_real() noexcept = default;
 
-		_Iterator_base_real(const _Iterator_base_real& right) noexcept {
-			*this = right;
+		_Iterator_base_real(const _Iterator_base_real& right) noexcept
+			: proxy_(right.proxy_), generation_(right.generation_) {
+			if (proxy_) { proxy_->_Retain(); }
 		}
 
 		_Iterator_base_real& operator=(const _Iterator_base_real& right) noexcept {
-			_Assign(right);
+			if (right.proxy_) { right.proxy_->_Retain(); }
+			if (proxy_) { proxy_->_Release(); }
+			proxy_ = right.proxy_;
+			generation_ = right.generation_;
 			return *this;
 		}
 
 		~_Iterator_base_real() noexcept {
-			_Orphan_me();
+			if (proxy_) { proxy_->_Release(); }
 		}
 
+		// 迭代器已失效或容器已销毁时返回 nullptr
 		const _Container_base_real* _Getcont() const noexcept {
-			return proxy_ ? proxy_->cont_ : nullptr;
+			return proxy_ && proxy_->generation_ == generation_ ? proxy_->cont_ : nullptr;
 		}
 
-		// ʼ
+		// 容器创建迭代器时调用，记录当前代数
 		void _Adopt(const _Container_base_real* parent) noexcept {
-			if (!parent) { _Orphan_me(); return; }
-			_Container_proxy* parent_proxy = parent->proxy_;
-			if (proxy_ != parent_proxy) {
-				if (!proxy_) _Orphan_me();
-				nextiter_ = parent_proxy->firstiter_;
-				parent_proxy->firstiter_ = this;
-				proxy_ = parent_proxy;
-			}
-		}
-
-	private:
-
-		void _Assign(const _Iterator_base_real& right) {
-			if (proxy_ == right.proxy_) return;
-			if (right.proxy_) {
-				_Adopt(right.proxy_->cont_);
-			}
-			else {
-				_Orphan_me();
-			}
+			_Container_proxy* new_proxy = parent ? parent->_Get_proxy() : nullptr;
+			if (new_proxy) { new_proxy->_Retain(); }
+			if (proxy_) { proxy_->_Release(); }
+			proxy_ = new_proxy;
+			generation_ = new_proxy ? new_proxy->generation_ : 0;
 		}
 
-		// ӵƳproxy_Ϊ
-		void _Orphan_me() {
-			if (!proxy_) return;
-			_Iterator_base_real** pnext = &proxy_->firstiter_;
-			while (*pnext && *pnext != this) {
-				pnext = &(*pnext)->nextiter_;
-			}
-			_MSTD_VERIFY(*pnext, "iterator list corrupted");
-			*pnext = nextiter_;
-			proxy_ = nullptr;
+		// 容器内部使用的迭代器没有绑定 proxy，不做检查
+		void _Verify_current(const char* mesg) const noexcept {
+			_MSTD_VERIFY(!proxy_ || _Getcont() != nullptr, mesg);
 		}
 
+		static constexpr bool _Unwrap_when_unverified = false;
 	};
 
-	void _Container_base_real::_Orphan_all() noexcept {
-		if (!proxy_) { return; }
-		auto pnext = mstd::exchange(proxy_->firstiter_, nullptr);
-		for (; pnext; pnext = pnext->nextiter_) {
-			pnext->proxy_ = nullptr;
-		}
-	}
-
-	void _Container_base_real::_Swap_proxy_and_iterators(_Container_base_real& right) noexcept {
-		_Container_proxy* temp = proxy_;
-		proxy_ = right.proxy_;
-		right.proxy_ = temp;
-
-		if (proxy_) {
-			proxy_->cont_ = this;
-		}
-
-		if (right.proxy_) {
-			right.proxy_->cont_ = &right;
-		}
-	}
-
 #if _ITERATOR_DEBUG != 0
 
 	using _Container_base = _Container_base_real;
 	using _Iterator_base = _Iterator_base_real;
 
-#define _CHANGE_TO_PROXY_ALLOC(_Alloc_t, alloc) static_cast<_Rebind_alloc_t<_Alloc_t, _Container_proxy>>(alloc)
-
 #else
 	using _Container_base = _Container_base_fake;
 	using _Iterator_base = _Iterator_base_fake;
 
-	constexpr _Fake_allocator _fake_alloc{};
-#define _CHANGE_TO_PROXY_ALLOC(_Alloc_t, _fake_alloc) _fake_alloc
-
 #endif
 
-
-	// ֹڴʧܳڴй©
-	struct _Basic_container_proxy_ptr {
-		_Container_proxy* ptr_{};
-		constexpr void _Release() noexcept { ptr_ = nullptr; }
-	protected:
-		_Basic_container_proxy_ptr() = default;
-		_Basic_container_proxy_ptr(const _Basic_container_proxy_ptr&) = delete;
-		_Basic_container_proxy_ptr(_Basic_container_proxy_ptr&&) = delete;
-	};
-
-	// ǩָ࣬ʾĬϷʽ
-	struct _Leave_proxy_unbound {
-		explicit _Leave_proxy_unbound() = default;
-	};
-
+	// 容器只保存指向堆内存的指针和分配器时，分配器可以按字节搬移则容器也可以；
+	// _ITERATOR_DEBUG 下 proxy 指回容器对象本身，按字节搬移后 proxy 会指向旧地址，不能搬移
 	template<class Alloc>
-	struct _Container_proxy_ptr : _Basic_container_proxy_ptr {
-		Alloc& alloc_;
-		_Container_proxy_ptr(Alloc& alloc, _Leave_proxy_unbound) : alloc_(alloc) {
-			ptr_ = _Unfancy(alloc.allocate(1));
-			_Construct_in_place(*ptr_);
-		}
-
-		_Container_proxy_ptr(Alloc& alloc, _Container_base_real& cont) : alloc_(alloc) {
-			ptr_ = _Unfancy(alloc.allocate(1));
-			_Construct_in_place(*ptr_, std::addressof(cont));
-			cont->proxy_ = ptr_;
-		}
-
-		void _Bind(Alloc& old_alloc, _Container_base_real* cont) noexcept {
-			ptr_->cont_ = cont;
-			_Delete_plain_internal(old_alloc, mstd::exchange(cont->proxy_, mstd::exchange(ptr_, nullptr)));
-		}
-
-		~_Container_proxy_ptr() {
-			if (ptr_) _Delete_plain_internal(alloc_, ptr_);
-		}
-
-	};
+	struct _Container_is_trivially_relocatable
+		: bool_constant<_ITERATOR_DEBUG == 0 && is_trivially_relocatable<Alloc>::value> {};
 
 
-	// ǩָ࣬ʾغþ
+	// 标签类，用于指示重载函数调用决议
 	struct _Zero_then_variadic_args_t {
 		explicit _Zero_then_variadic_args_t() = default;
 	};
@@ -1020,7 +1057,7 @@ namespace mstd {
 		explicit _One_then_variadic_args_t() = default;
 	};
 
-	// ۺ࣬ڽʡŶڴռ䣨ʡΪֿ趨ڴռ䣩
+	// 聚合类，用于节省存放对象内存空间（节省为了区分空类对象而设定的内存空间）
 	template<class Tp1, class Tp2, bool = is_empty<Tp1>::value && !is_final<Tp1>::value>
 	struct _Compressed_pair final : private Tp1 {
 	public:
@@ -0,0 +1,498 @@
+#pragma once
+
+#include <cstddef>			// std::max_align_t;
+#include <new>				// std::bad_alloc; std::align_val_t;
+#include <memory>			// std::align();
+#include <atomic>			// std::atomic;
+#include <mutex>			// std::mutex;
+
+#include "m_type_traits.h"	// is_constructible<>; is_convertible_v<>;
+#include "m_utility.h"		// forward();
+
+namespace mstd {
+namespace pmr {
+
+	// 多态内存资源：容器只依赖 polymorphic_allocator 一种类型，运行时决定内存从哪里来
+	class memory_resource {
+		static constexpr size_t _Max_align = alignof(std::max_align_t);
+
+	public:
+		virtual ~memory_resource() = default;
+
+		void* allocate(size_t bytes, size_t align = _Max_align) {
+			return do_allocate(bytes, align);
+		}
+
+		void deallocate(void* p, size_t bytes, size_t align = _Max_align) {
+			do_deallocate(p, bytes, align);
+		}
+
+		bool is_equal(const memory_resource& other) const noexcept {
+			return do_is_equal(other);
+		}
+
+	private:
+		virtual void* do_allocate(size_t bytes, size_t align) = 0;
+		virtual void do_deallocate(void* p, size_t bytes, size_t align) = 0;
+		virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+	};
+
+	inline bool operator==(const memory_resource& left, const memory_resource& right) noexcept {
+		return &left == &right || left.is_equal(right);
+	}
+
+	inline bool operator!=(const memory_resource& left, const memory_resource& right) noexcept {
+		return !(left == right);
+	}
+
+	// ::operator new / ::operator delete
+	class _New_delete_resource final : public memory_resource {
+		void* do_allocate(size_t bytes, size_t align) override {
+			if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+				return ::operator new(bytes, std::align_val_t{ align });
+			}
+			return ::operator new(bytes);
+		}
+
+		void do_deallocate(void* p, size_t bytes, size_t align) override {
+			if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+				::operator delete(p, bytes, std::align_val_t{ align });
+			}
+			else {
+				::operator delete(p, bytes);
+			}
+		}
+
+		bool do_is_equal(const memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+	// 总是抛出 bad_alloc，作为上游资源时可以保证只使用给定的缓冲区
+	class _Null_resource final : public memory_resource {
+		void* do_allocate(size_t, size_t) override {
+			throw std::bad_alloc{};
+		}
+
+		void do_deallocate(void*, size_t, size_t) override {}
+
+		bool do_is_equal(const memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+	inline memory_resource* new_delete_resource() noexcept {
+		static _New_delete_resource resource;
+		return &resource;
+	}
+
+	inline memory_resource* null_memory_resource() noexcept {
+		static _Null_resource resource;
+		return &resource;
+	}
+
+	inline std::atomic<memory_resource*>& _Default_resource() noexcept {
+		static std::atomic<memory_resource*> resource{ new_delete_resource() };
+		return resource;
+	}
+
+	inline memory_resource* get_default_resource() noexcept {
+		return _Default_resource().load(std::memory_order_acquire);
+	}
+
+	// 返回之前的默认资源，传入 nullptr 时恢复为 new_delete_resource()
+	inline memory_resource* set_default_resource(memory_resource* resource) noexcept {
+		if (nullptr == resource) { resource = new_delete_resource(); }
+		return _Default_resource().exchange(resource, std::memory_order_acq_rel);
+	}
+
+	// 单调缓冲区资源：在给定缓冲区和逐步增长的上游内存块上移动指针分配，
+	// deallocate 为空操作，release() 或析构时一次性归还，非线程安全
+	class monotonic_buffer_resource : public memory_resource {
+		struct _Block {
+			_Block* next;
+			size_t bytes;	// 含 _Block 本身的字节数
+		};
+
+		static constexpr size_t _Default_size = 1024;
+
+		memory_resource* upstream_;
+		void* buffer_ = nullptr;	// 调用者提供的初始缓冲区
+		size_t buffer_size_ = 0;
+		void* cur_ = nullptr;
+		size_t space_ = 0;
+		size_t next_size_ = _Default_size;
+		_Block* blocks_ = nullptr;
+
+	public:
+		monotonic_buffer_resource() : monotonic_buffer_resource(get_default_resource()) {}
+
+		explicit monotonic_buffer_resource(memory_resource* upstream) noexcept : upstream_(upstream) {}
+
+		monotonic_buffer_resource(size_t initial_size, memory_resource* upstream = get_default_resource()) noexcept
+			: upstream_(upstream), next_size_(initial_size < sizeof(_Block) ? _Default_size : initial_size) {}
+
+		monotonic_buffer_resource(void* buffer, size_t buffer_size, memory_resource* upstream = get_default_resource()) noexcept
+			: upstream_(upstream), buffer_(buffer), buffer_size_(buffer_size), cur_(buffer), space_(buffer_size),
+			next_size_(buffer_size < _Default_size ? _Default_size : 2 * buffer_size) {}
+
+		monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+		monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+		~monotonic_buffer_resource() override { release(); }
+
+		// 归还全部上游内存块，重新从初始缓冲区开始分配
+		void release() noexcept {
+			while (nullptr != blocks_) {
+				_Block* next = blocks_->next;
+				upstream_->deallocate(blocks_, blocks_->bytes, alignof(std::max_align_t));
+				blocks_ = next;
+			}
+			cur_ = buffer_;
+			space_ = buffer_size_;
+		}
+
+		memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+	private:
+		void* do_allocate(size_t bytes, size_t align) override {
+			void* result = std::align(align, bytes, cur_, space_);
+			if (nullptr == result) {
+				grow(bytes, align);
+				result = std::align(align, bytes, cur_, space_);
+			}
+			cur_ = static_cast<char*>(result) + bytes;
+			space_ -= bytes;
+			return result;
+		}
+
+		void do_deallocate(void*, size_t, size_t) override {}
+
+		bool do_is_equal(const memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+
+		// 向上游申请足够容纳 bytes 字节和对齐余量的内存块，之后的块大小按2倍增长
+		void grow(size_t bytes, size_t align) {
+			size_t need = sizeof(_Block) + bytes + align;
+			size_t block_size = next_size_ < need ? need : next_size_;
+			auto block = static_cast<_Block*>(upstream_->allocate(block_size, alignof(std::max_align_t)));
+			block->next = blocks_;
+			block->bytes = block_size;
+			blocks_ = block;
+			cur_ = block + 1;
+			space_ = block_size - sizeof(_Block);
+			next_size_ = 2 * block_size;
+		}
+	};
+
+	struct pool_options {
+		size_t max_blocks_per_chunk = 0;		// 每个 chunk 最多的内存块数，0表示使用默认值
+		size_t largest_required_pool_block = 0;	// 由内存池管理的最大内存块，更大的请求直接交给上游资源
+	};
+
+	// 非同步内存池资源：按2的幂划分大小类别，每个类别从上游申请 chunk 并切分成内存块，
+	// 每个类别的 chunk 从8块开始按2倍增长到 max_blocks_per_chunk，非线程安全
+	class unsynchronized_pool_resource : public memory_resource {
+		struct _Free_block {
+			_Free_block* next;
+		};
+
+		struct alignas(std::max_align_t) _Chunk {
+			_Chunk* next;
+			size_t bytes;	// 含 _Chunk 本身的字节数
+		};
+
+		struct _Pool {
+			_Free_block* free_ = nullptr;
+			_Chunk* chunks_ = nullptr;
+			size_t next_blocks_ = 8;
+		};
+
+		// 超过 largest_required_pool_block 的内存块，紧挨用户内存之前放置头部，串成双向链表以便 release() 时归还
+		struct _Oversized {
+			_Oversized* prev;
+			_Oversized* next;
+			size_t bytes;	// 向上游申请的字节数
+			size_t align;	// 向上游申请时的对齐
+		};
+
+		static constexpr size_t _Min_block = 8;
+		static constexpr size_t _Max_pools = 18;	// 8B ~ 1MiB
+		static constexpr size_t _Default_largest = 4096;
+		static constexpr size_t _Default_max_blocks = 1024;
+		static constexpr size_t _Max_chunk_bytes = size_t(4) << 20;	// 单个 chunk 中内存块的总字节数上限，不小于最大的内存块
+
+		static_assert(_Max_chunk_bytes >= (_Min_block << (_Max_pools - 1)), "每个 chunk 至少容纳一个最大的内存块");
+
+		memory_resource* upstream_;
+		pool_options options_;
+		size_t n_pools_;
+		_Pool pools_[_Max_pools];
+		_Oversized* oversized_ = nullptr;
+
+		static size_t round_up_pow2(size_t bytes) noexcept {
+			size_t size = _Min_block;
+			while (size < bytes) { size <<= 1; }
+			return size;
+		}
+
+		// 返回大小类别的索引，不属于内存池管理时返回 n_pools_
+		size_t pool_index(size_t bytes, size_t align) const noexcept {
+			if (align > alignof(std::max_align_t)) { return n_pools_; }
+			if (bytes < align) { bytes = align; }
+			size_t index = 0;
+			for (size_t size = _Min_block; size < bytes && index < n_pools_; size <<= 1) { ++index; }
+			return index;
+		}
+
+		static size_t block_size(size_t index) noexcept {
+			return _Min_block << index;
+		}
+
+		// 头部占用的字节数，保证用户内存按 align 对齐
+		static size_t oversized_header(size_t align) noexcept {
+			return (sizeof(_Oversized) + align - 1) / align * align;
+		}
+
+		static void* oversized_base(_Oversized* node) noexcept {
+			return reinterpret_cast<char*>(node + 1) - oversized_header(node->align);
+		}
+
+		void refill(size_t index) {
+			_Pool& pool = pools_[index];
+			const size_t size = block_size(index);
+			// 大内存块的类别按字节数限制块数，避免 max_blocks_per_chunk 较大时一次向上游申请过多内存或 n * size 溢出
+			const size_t n = pool.next_blocks_ < _Max_chunk_bytes / size ? pool.next_blocks_ : _Max_chunk_bytes / size;
+			const size_t bytes = sizeof(_Chunk) + n * size;
+			auto chunk = static_cast<_Chunk*>(upstream_->allocate(bytes, alignof(_Chunk)));
+			chunk->next = pool.chunks_;
+			chunk->bytes = bytes;
+			pool.chunks_ = chunk;
+			char* first = reinterpret_cast<char*>(chunk + 1);
+			for (size_t i = n; i > 0; --i) {
+				auto block = reinterpret_cast<_Free_block*>(first + (i - 1) * size);
+				block->next = pool.free_;
+				pool.free_ = block;
+			}
+			if (n == pool.next_blocks_ && pool.next_blocks_ < options_.max_blocks_per_chunk) {
+				pool.next_blocks_ = 2 * pool.next_blocks_ < options_.max_blocks_per_chunk
+					? 2 * pool.next_blocks_ : options_.max_blocks_per_chunk;
+			}
+		}
+
+	public:
+		unsynchronized_pool_resource() : unsynchronized_pool_resource(pool_options{}, get_default_resource()) {}
+
+		explicit unsynchronized_pool_resource(memory_resource* upstream)
+			: unsynchronized_pool_resource(pool_options{}, upstream) {}
+
+		explicit unsynchronized_pool_resource(const pool_options& options)
+			: unsynchronized_pool_resource(options, get_default_resource()) {}
+
+		unsynchronized_pool_resource(const pool_options& options, memory_resource* upstream)
+			: upstream_(upstream), options_(options) {
+			if (0 == options_.max_blocks_per_chunk) { options_.max_blocks_per_chunk = _Default_max_blocks; }
+			if (options_.max_blocks_per_chunk < _Min_block) { options_.max_blocks_per_chunk = _Min_block; }
+			if (0 == options_.largest_required_pool_block) { options_.largest_required_pool_block = _Default_largest; }
+			if (options_.largest_required_pool_block > block_size(_Max_pools - 1)) {
+				options_.largest_required_pool_block = block_size(_Max_pools - 1);
+			}
+			options_.largest_required_pool_block = round_up_pow2(options_.largest_required_pool_block);
+			n_pools_ = 1;
+			while (block_size(n_pools_ - 1) < options_.largest_required_pool_block) { ++n_pools_; }
+		}
+
+		unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+		unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+		~unsynchronized_pool_resource() override { release(); }
+
+		// 将所有 chunk 和超大内存块归还上游资源，即使还有内存块没有 deallocate
+		void release() noexcept {
+			for (size_t i = 0; i < n_pools_; ++i) {
+				_Pool& pool = pools_[i];
+				while (nullptr != pool.chunks_) {
+					_Chunk* next = pool.chunks_->next;
+					upstream_->deallocate(pool.chunks_, pool.chunks_->bytes, alignof(_Chunk));
+					pool.chunks_ = next;
+				}
+				pool = _Pool{};
+			}
+			while (nullptr != oversized_) {
+				_Oversized* next = oversized_->next;
+				upstream_->deallocate(oversized_base(oversized_), oversized_->bytes, oversized_->align);
+				oversized_ = next;
+			}
+		}
+
+		memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+		pool_options options() const noexcept { return options_; }
+
+	protected:
+		void* do_allocate(size_t bytes, size_t align) override {
+			const size_t index = pool_index(bytes, align);
+			if (index < n_pools_) {
+				_Pool& pool = pools_[index];
+				if (nullptr == pool.free_) { refill(index); }
+				_Free_block* result = pool.free_;
+				pool.free_ = result->next;
+				return result;
+			}
+			return allocate_oversized(bytes, align);
+		}
+
+		void do_deallocate(void* p, size_t bytes, size_t align) override {
+			if (nullptr == p) { return; }
+			const size_t index = pool_index(bytes, align);
+			if (index < n_pools_) {
+				auto block = static_cast<_Free_block*>(p);
+				block->next = pools_[index].free_;
+				pools_[index].free_ = block;
+				return;
+			}
+			deallocate_oversized(p);
+		}
+
+		bool do_is_equal(const memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+
+	private:
+		void* allocate_oversized(size_t bytes, size_t align) {
+			if (align < alignof(std::max_align_t)) { align = alignof(std::max_align_t); }
+			const size_t total = oversized_header(align) + bytes;
+			char* base = static_cast<char*>(upstream_->allocate(total, align));
+			auto node = reinterpret_cast<_Oversized*>(base + oversized_header(align)) - 1;
+			node->prev = nullptr;
+			node->next = oversized_;
+			node->bytes = total;
+			node->align = align;
+			if (nullptr != oversized_) { oversized_->prev = node; }
+			oversized_ = node;
+			return node + 1;
+		}
+
+		void deallocate_oversized(void* p) noexcept {
+			auto node = static_cast<_Oversized*>(p) - 1;
+			if (nullptr != node->prev) { node->prev->next = node->next; }
+			else { oversized_ = node->next; }
+			if (nullptr != node->next) { node->next->prev = node->prev; }
+			upstream_->deallocate(oversized_base(node), node->bytes, node->align);
+		}
+	};
+
+	// 同步内存池资源：用互斥量保护 unsynchronized_pool_resource，可以在多个线程间共享
+	class synchronized_pool_resource : public memory_resource {
+		mutable std::mutex mtx_;
+		unsynchronized_pool_resource pool_;
+
+	public:
+		synchronized_pool_resource() : pool_() {}
+
+		explicit synchronized_pool_resource(memory_resource* upstream) : pool_(upstream) {}
+
+		explicit synchronized_pool_resource(const pool_options& options) : pool_(options) {}
+
+		synchronized_pool_resource(const pool_options& options, memory_resource* upstream) : pool_(options, upstream) {}
+
+		synchronized_pool_resource(const synchronized_pool_resource&) = delete;
+		synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
+
+		void release() {
+			std::lock_guard<std::mutex> lock(mtx_);
+			pool_.release();
+		}
+
+		memory_resource* upstream_resource() const noexcept { return pool_.upstream_resource(); }
+
+		pool_options options() const noexcept { return pool_.options(); }
+
+	protected:
+		void* do_allocate(size_t bytes, size_t align) override {
+			std::lock_guard<std::mutex> lock(mtx_);
+			return pool_.allocate(bytes, align);
+		}
+
+		void do_deallocate(void* p, size_t bytes, size_t align) override {
+			std::lock_guard<std::mutex> lock(mtx_);
+			pool_.deallocate(p, bytes, align);
+		}
+
+		bool do_is_equal(const memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+	template<class Tp>
+	class polymorphic_allocator;
+
+	// 元素类型的 allocator_type 可以由 polymorphic_allocator 转换且支持尾部分配器参数时，构造元素时传入分配器
+	template<class Tp, class Alloc, class = void>
+	struct _Uses_pmr_allocator : false_type {};
+
+	template<class Tp, class Alloc>
+	struct _Uses_pmr_allocator<Tp, Alloc, void_t<typename Tp::allocator_type>>
+		: bool_constant<is_convertible_v<Alloc, typename Tp::allocator_type>> {};
+
+	// 多态分配器：分配委托给 memory_resource，不同资源的容器是同一类型
+	// 拷贝赋值、移动赋值、交换时不传播，容器复制时使用默认资源
+	template<class Tp>
+	class polymorphic_allocator {
+		memory_resource* resource_;
+
+	public:
+		using value_type = Tp;
+
+		polymorphic_allocator() noexcept : resource_(get_default_resource()) {}
+
+		polymorphic_allocator(memory_resource* resource) noexcept : resource_(resource) {}
+
+		polymorphic_allocator(const polymorphic_allocator&) = default;
+
+		template<class Other>
+		polymorphic_allocator(const polymorphic_allocator<Other>& other) noexcept : resource_(other.resource()) {}
+
+		polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;
+
+		Tp* allocate(size_t count) {
+			if (count > static_cast<size_t>(-1) / sizeof(Tp)) { throw std::bad_array_new_length{}; }
+			return static_cast<Tp*>(resource_->allocate(count * sizeof(Tp), alignof(Tp)));
+		}
+
+		void deallocate(Tp* ptr, size_t count) noexcept {
+			resource_->deallocate(ptr, count * sizeof(Tp), alignof(Tp));
+		}
+
+		// 嵌套的 pmr 容器使用同一个内存资源
+		template<class Utp, class... Args>
+		void construct(Utp* ptr, Args&&... args) {
+			if constexpr (_Uses_pmr_allocator<Utp, polymorphic_allocator>::value
+				&& is_constructible<Utp, Args..., const polymorphic_allocator&>::value) {
+				::new (static_cast<void*>(ptr)) Utp(mstd::forward<Args>(args)..., *this);
+			}
+			else {
+				::new (static_cast<void*>(ptr)) Utp(mstd::forward<Args>(args)...);
+			}
+		}
+
+		polymorphic_allocator select_on_container_copy_construction() const noexcept {
+			return polymorphic_allocator{};
+		}
+
+		memory_resource* resource() const noexcept { return resource_; }
+	};
+
+	template<class Tp, class Other>
+	inline bool operator==(const polymorphic_allocator<Tp>& left, const polymorphic_allocator<Other>& right) noexcept {
+		return *left.resource() == *right.resource();
+	}
+
+	template<class Tp, class Other>
+	inline bool operator!=(const polymorphic_allocator<Tp>& left, const polymorphic_allocator<Other>& right) noexcept {
+		return !(left == right);
+	}
+
+}
+}
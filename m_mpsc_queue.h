@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>				// std::atomic<>;
+#include <cstddef>
+#include <thread>				// std::this_thread::yield();
+
+#include "m_alloc.h"			// thread_cache_allocator;
+#include "m_memory.h"			// _Container_alloc_t<>; allocator_traits<>;
+#include "m_constructor.h"		// construct(); destroy();
+#include "m_utility.h"			// move(); forward();
+
+namespace mstd {
+
+	// 无界无锁多生产者单消费者队列(Dmitry Vyukov 的算法)
+	// 链表头部总有一个不含元素的哑节点，元素存放在它之后的节点中；
+	// 生产者只做一次 exchange 取得尾节点再链接上去，不需要重试；
+	// 节点默认从 thread_cache_allocator 分配，生产者和消费者各自在线程缓存中分配/释放，很少访问中心池。
+	// 只允许一个线程调用 try_pop/consume_all/empty
+	template<class Tp, class Alloc = thread_cache_allocator<0>>
+	class mpsc_queue
+	{
+	private:
+		struct _Node {
+			std::atomic<_Node*> next_;
+			alignas(Tp) unsigned char buf_[sizeof(Tp)];
+
+			Tp* _Ptr() noexcept { return reinterpret_cast<Tp*>(buf_); }
+		};
+
+		using _Alnode = _Container_alloc_t<Alloc, _Node>;
+		using _Alnode_traits = allocator_traits<_Alnode>;
+
+		_Alnode alloc_;
+		_Node* head_ = nullptr;										// 哑节点，只有消费者访问
+		alignas(64) std::atomic<_Node*> tail_{ nullptr };			// 最后一个节点，生产者 exchange
+
+		// 分配节点，不构造元素
+		_Node* _Buy_node() {
+			_Node* const node = _Alnode_traits::allocate(alloc_, 1);
+			::new (static_cast<void*>(&node->next_)) std::atomic<_Node*>(nullptr);
+			return node;
+		}
+
+		void _Free_node(_Node* node) noexcept {
+			_Alnode_traits::deallocate(alloc_, node, 1);
+		}
+
+		// 把 node 接到链表尾部，exchange 之后到链接之前，消费者看到的链表在 prev 处暂时断开
+		void _Link(_Node* node) noexcept {
+			_Node* const prev = tail_.exchange(node, std::memory_order_acq_rel);
+			prev->next_.store(node, std::memory_order_release);
+		}
+
+		// 等待已 exchange 但尚未链接的生产者完成链接
+		static _Node* _Wait_next(_Node* node) noexcept {
+			_Node* next = node->next_.load(std::memory_order_acquire);
+			while (nullptr == next) {
+				std::this_thread::yield();
+				next = node->next_.load(std::memory_order_acquire);
+			}
+			return next;
+		}
+
+		// 元素交给消费者后析构，回调抛出异常时同样析构
+		struct _Destroy_value {
+			_Node* node_;
+
+			~_Destroy_value() { mstd::destroy(node_->_Ptr()); }
+		};
+
+	public:
+		using value_type = Tp;
+		using size_type = size_t;
+		using allocator_type = _Alnode;
+
+		explicit mpsc_queue(const allocator_type& alloc = allocator_type())
+			: alloc_(alloc) {
+			head_ = _Buy_node();
+			tail_.store(head_, std::memory_order_relaxed);
+		}
+
+		mpsc_queue(const mpsc_queue&) = delete;
+		mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+		// 析构时不能有其他线程访问队列
+		~mpsc_queue() {
+			_Node* node = head_;
+			_Node* next = node->next_.load(std::memory_order_relaxed);
+			_Free_node(node);
+			while (nullptr != next) {
+				node = next;
+				next = node->next_.load(std::memory_order_relaxed);
+				mstd::destroy(node->_Ptr());
+				_Free_node(node);
+			}
+		}
+
+		// 除分配节点和构造元素外是无等待的
+		template<class... Args>
+		void emplace(Args&&... args) {
+			_Node* const node = _Buy_node();
+			try {
+				mstd::construct(node->_Ptr(), mstd::forward<Args>(args)...);
+			}
+			catch (...) {
+				_Free_node(node);
+				throw;
+			}
+			_Link(node);
+		}
+
+		void push(const Tp& val) { emplace(val); }
+		void push(Tp&& val) { emplace(mstd::move(val)); }
+
+		// 队列空时返回 false。第一个元素的生产者尚未完成链接时也返回 false
+		bool try_pop(Tp& out) {
+			_Node* const next = head_->next_.load(std::memory_order_acquire);
+			if (nullptr == next) { return false; }
+			out = mstd::move(*next->_Ptr());
+			mstd::destroy(next->_Ptr());
+			_Free_node(head_);
+			head_ = next;
+			return true;
+		}
+
+		// 读取一次 tail_ 确定本批次的最后一个节点，按入队顺序对每个元素调用 func(Tp&)，返回元素个数。
+		// 之后的 push 只会链接在该节点之后，不会延长本次处理的链表；
+		// func 抛出异常时，未处理的元素留在队列中
+		template<class Func>
+		size_t consume_all(Func func) {
+			_Node* const last = tail_.load(std::memory_order_acquire);
+			size_t count = 0;
+			while (head_ != last) {
+				_Node* const next = _Wait_next(head_);
+				_Free_node(head_);
+				head_ = next;
+				++count;
+				_Destroy_value guard{ next };
+				func(*next->_Ptr());
+			}
+			return count;
+		}
+
+		// 只在消费者线程调用有意义
+		bool empty() const noexcept {
+			return nullptr == head_->next_.load(std::memory_order_acquire);
+		}
+	};
+
+}
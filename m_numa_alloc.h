@@ -0,0 +1,460 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <mutex>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+// 定义 _MSTD_USE_LIBNUMA 为1时通过 libnuma 查询节点、绑定内存(需链接 -lnuma)
+// 否则在 Linux 上直接使用 getcpu/mbind 系统调用，其他平台退化为 first-touch
+#ifndef _MSTD_USE_LIBNUMA
+#define _MSTD_USE_LIBNUMA 0
+#endif
+
+#if _MSTD_USE_LIBNUMA
+#include <numa.h>
+#include <sched.h>
+#endif
+
+#include "m_alloc.h"
+
+namespace mstd {
+
+	// 与操作系统相关的部分：查询当前线程所在节点，按节点申请/归还整页内存
+	struct _Numa_os {
+		static size_t page_size() noexcept {
+#if defined(__linux__)
+			static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			return size;
+#else
+			return 4096;
+#endif
+		}
+
+		// 当前线程所在CPU的节点，无法查询时返回0
+		static int current_node() noexcept {
+#if _MSTD_USE_LIBNUMA
+			if (numa_available() >= 0) {
+				int cpu = sched_getcpu();
+				int node = cpu >= 0 ? numa_node_of_cpu(cpu) : -1;
+				if (node >= 0) { return node; }
+			}
+#elif defined(__linux__) && defined(SYS_getcpu)
+			unsigned cpu = 0, node = 0;
+			if (0 == syscall(SYS_getcpu, &cpu, &node, nullptr)) { return static_cast<int>(node); }
+#endif
+			return 0;
+		}
+
+		// 将[p, p + bytes)优先放在node上，失败(内核不支持NUMA等)时忽略，由 first-touch 决定位置
+		static void bind(void* p, size_t bytes, int node) noexcept {
+#if _MSTD_USE_LIBNUMA
+			if (numa_available() >= 0) { numa_tonode_memory(p, bytes, node); }
+#elif defined(__linux__) && defined(SYS_mbind)
+			if (node < 0 || node >= static_cast<int>(8 * sizeof(unsigned long))) { return; }
+			const unsigned long mask = 1UL << node;
+			const int mpol_preferred = 1;
+			syscall(SYS_mbind, p, bytes, mpol_preferred, &mask, 8 * sizeof(mask) + 1, 0);
+#else
+			(void)p; (void)bytes; (void)node;
+#endif
+		}
+
+		// 申请bytes字节、按align对齐的内存并绑定到node，align为2的幂且bytes为align的整数倍，失败返回nullptr
+		static void* map(size_t bytes, size_t align, int node) noexcept {
+#if defined(__linux__)
+			if (align < page_size()) { align = page_size(); }
+			const size_t len = align > page_size() ? bytes + align : bytes;
+			void* raw = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (MAP_FAILED == raw) { return nullptr; }
+			//多申请了align字节，把首尾多出的部分还回去
+			auto first = reinterpret_cast<std::uintptr_t>(raw);
+			auto aligned = (first + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+			if (aligned != first) { munmap(raw, aligned - first); }
+			if (len > aligned - first + bytes) {
+				munmap(reinterpret_cast<void*>(aligned + bytes), len - (aligned - first) - bytes);
+			}
+			void* result = reinterpret_cast<void*>(aligned);
+			bind(result, bytes, node);
+			return result;
+#elif defined(_WIN32)
+			(void)node;
+			return _aligned_malloc(bytes, align);
+#else
+			(void)node;
+			return std::aligned_alloc(align, bytes);
+#endif
+		}
+
+		static void unmap(void* p, size_t bytes) noexcept {
+#if defined(__linux__)
+			munmap(p, bytes);
+#elif defined(_WIN32)
+			(void)bytes;
+			_aligned_free(p);
+#else
+			(void)bytes;
+			std::free(p);
+#endif
+		}
+	};
+
+	//按NUMA节点划分的内存池，每个节点有独立的自由链表和chunk，切分方式与 pool_allocator 相同
+	//chunk按自身大小对齐，头部记录所属节点，释放时由地址找到节点，内存块总是回到原节点
+	//介于 MAX_BYTES 和 LARGE_BYTES 之间的请求向上取为2的幂，从本节点单独的chunk中切分；
+	//不小于 LARGE_BYTES 的请求直接按页申请并绑定节点，头部同样记录节点
+	template <int inst, class Policy = pool_linear_policy<>, size_t MaxNodes = 8>
+	class numa_pool_allocator
+	{
+	private:
+		enum : size_t { MAX_BYTES = Policy::max_bytes };
+		enum : size_t { NFREELISTS = Policy::n_classes };
+		enum : size_t { CHUNK_BYTES = size_t(1) << 18 };
+		enum : size_t { LARGE_BYTES = size_t(1) << 16 };
+
+		//中等大小类别：MID_MIN, 2*MID_MIN, ..., LARGE_BYTES(小于 LARGE_BYTES 的请求向上取整后可能等于它)
+		static constexpr size_t pow2_ceil(size_t size) noexcept {
+			size_t result = 1;
+			while (result < size) { result *= 2; }
+			return result;
+		}
+		static constexpr size_t log2_floor(size_t size) noexcept {
+			size_t result = 0;
+			while (size > 1) { size /= 2; ++result; }
+			return result;
+		}
+		static constexpr size_t MID_MIN = pow2_ceil(MAX_BYTES + 1);
+		static constexpr size_t NMIDLISTS = log2_floor(LARGE_BYTES) - log2_floor(MID_MIN) + 1;
+
+		struct obj { //free-lists 的节点
+			obj* next;
+		};
+
+		struct alignas(64) chunk_header {
+			chunk_header* next;
+			size_t node;
+		};
+
+		static_assert(0 < MaxNodes, "MaxNodes must be positive.");
+		static_assert(MID_MIN < LARGE_BYTES, "Policy::max_bytes must be below LARGE_BYTES.");
+		static_assert(Policy::max_n_obj * Policy::max_bytes <= CHUNK_BYTES - sizeof(chunk_header),
+			"a refill batch must fit in one chunk.");
+
+		//每个节点的中心池，对齐到缓存行避免不同节点的线程互相干扰
+		struct alignas(64) node_pool {
+			_Tagged_stack<obj> free_list[NFREELISTS];
+			std::mutex chunk_mutex;		// 保护以下成员
+			chunk_header* chunk_list = nullptr;
+			char* start = nullptr;
+			char* end = nullptr;
+			size_t heap_size = 0;
+			size_t refill_batch[NFREELISTS]{};
+			_Tagged_stack<obj> mid_list[NMIDLISTS];
+			char* mid_start = nullptr;	// 中等大小内存块所用chunk的剩余部分，同样由 chunk_mutex 保护
+			char* mid_end = nullptr;
+		};
+		static node_pool pools[MaxNodes];
+
+		//线程指定的节点，-1表示跟随线程当前所在的节点
+		static int& thread_node() noexcept {
+			thread_local int node = -1;
+			return node;
+		}
+
+		static size_t round_up(size_t size) {
+			return Policy::class_size(Policy::class_index(size));
+		}
+
+		static size_t free_list_index(size_t size) {
+			return Policy::class_index(size);
+		}
+
+		static size_t pool_index(int node) noexcept {
+			return node < 0 ? 0 : static_cast<size_t>(node) % MaxNodes;
+		}
+
+		static size_t mid_index(size_t size) noexcept {
+			return log2_floor(pow2_ceil(size)) - log2_floor(MID_MIN);
+		}
+
+		//大块前面放一个 chunk_header 记录节点
+		static size_t large_size(size_t size) noexcept {
+			const size_t page = _Numa_os::page_size();
+			return (size + sizeof(chunk_header) + page - 1) & ~(page - 1);
+		}
+
+		//由地址找到内存块所在的节点：池中的内存块由所在chunk的头部记录，大块由自身前面的头部记录
+		static chunk_header* header_of(void* p, size_t size) noexcept {
+			if (size >= static_cast<size_t>(LARGE_BYTES)) {
+				return static_cast<chunk_header*>(p) - 1;
+			}
+			return reinterpret_cast<chunk_header*>(
+				reinterpret_cast<std::uintptr_t>(p) & ~static_cast<std::uintptr_t>(CHUNK_BYTES - 1));
+		}
+
+		static size_t next_batch(node_pool& pool, size_t index) noexcept {
+			size_t batch = pool.refill_batch[index];
+			if (0 == batch) { batch = Policy::min_n_obj; }
+			pool.refill_batch[index] = batch < Policy::max_n_obj / 2 ? 2 * batch : Policy::max_n_obj;
+			return batch;
+		}
+
+		static void* chunk_alloc(node_pool& pool, size_t node, size_t size, size_t& m_n_obj);
+		static void* refill(node_pool& pool, size_t node, size_t size);
+		static void* mid_alloc(node_pool& pool, size_t node, size_t index);
+
+	public:
+		//节点号，set_thread_node 指定过则返回指定的节点，否则为线程当前所在的节点
+		static int current_node() noexcept {
+			const int node = thread_node();
+			return node >= 0 ? node : _Numa_os::current_node();
+		}
+
+		//指定当前线程以后从node分配，传入-1恢复为跟随线程所在的节点
+		static void set_thread_node(int node) noexcept { thread_node() = node; }
+
+		static void* allocate(size_t size) { return allocate_on(current_node(), size); }
+		static void* allocate_on(int node, size_t size);
+		static void* reallocate(void* p, size_t old_sz, size_t new_sz);
+		static void deallocate(void* p, size_t size);
+
+		//节点池向系统申请的内存总量(包括中等大小内存块的chunk)，不含直接按页申请的大块
+		static size_t heap_bytes(int node) {
+			node_pool& pool = pools[pool_index(node)];
+			std::lock_guard<std::mutex> lock(pool.chunk_mutex);
+			return pool.heap_size;
+		}
+	};
+
+	template <int inst, class Policy, size_t MaxNodes>
+	typename numa_pool_allocator<inst, Policy, MaxNodes>::node_pool
+		numa_pool_allocator<inst, Policy, MaxNodes>::pools[MaxNodes]{};
+
+	template <int inst, class Policy, size_t MaxNodes>
+	void* numa_pool_allocator<inst, Policy, MaxNodes>::
+		chunk_alloc(node_pool& pool, size_t node, size_t size, size_t& m_n_obj)
+	{
+		size_t total_bytes = m_n_obj * size;
+		size_t bytes_left = pool.end - pool.start;
+		char* result = nullptr;
+		if (bytes_left >= total_bytes) {
+			result = pool.start;
+			pool.start += total_bytes;
+			return result;
+		}
+		else if (bytes_left >= size) {
+			result = pool.start;
+			m_n_obj = bytes_left / size;
+			pool.start += m_n_obj * size;
+			return result;
+		}
+		else {
+			for (size_t index = free_list_index(size); bytes_left > 0; ) {
+				while (Policy::class_size(index) > bytes_left) { --index; }
+				pool.free_list[index].push(reinterpret_cast<obj*>(pool.start));
+				pool.start += Policy::class_size(index);
+				bytes_left -= Policy::class_size(index);
+			}
+			//新chunk由本节点分配，切分时写入的链表指针也由本节点的线程完成首次访问
+			result = static_cast<char*>(_Numa_os::map(CHUNK_BYTES, CHUNK_BYTES, static_cast<int>(node)));
+			if (nullptr == result) {
+				for (auto index = free_list_index(size); index < NFREELISTS; ++index) {
+					obj* block = pool.free_list[index].pop();
+					if (nullptr != block) {
+						pool.start = reinterpret_cast<char*>(block);
+						pool.end = pool.start + Policy::class_size(index);
+						return chunk_alloc(pool, node, size, m_n_obj);
+					}
+				}
+				throw std::bad_alloc();
+			}
+			auto header = reinterpret_cast<chunk_header*>(result);
+			header->next = pool.chunk_list;
+			header->node = node;
+			pool.chunk_list = header;
+			pool.start = result + sizeof(chunk_header);
+			pool.end = result + CHUNK_BYTES;
+			pool.heap_size += CHUNK_BYTES;
+			return chunk_alloc(pool, node, size, m_n_obj);
+		}
+	}
+
+	template <int inst, class Policy, size_t MaxNodes>
+	void* numa_pool_allocator<inst, Policy, MaxNodes>::refill(node_pool& pool, size_t node, size_t size)
+	{
+		size_t m_n_obj = 0;
+		char* result = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(pool.chunk_mutex);
+			m_n_obj = next_batch(pool, free_list_index(size));
+			result = static_cast<char*>(chunk_alloc(pool, node, size, m_n_obj));
+		}
+		if (1 == m_n_obj) { return result; }
+		obj* first = reinterpret_cast<obj*>(result + size);
+		obj* last = first;
+		for (size_t i = 2; i < m_n_obj; ++i) {
+			last->next = reinterpret_cast<obj*>(result + i * size);
+			last = last->next;
+		}
+		last->next = nullptr;
+		pool.free_list[free_list_index(size)].push_chain(first, last);
+		return result;
+	}
+
+	//中等大小的内存块从本节点的chunk中逐个切分，chunk剩余部分不够时切成更小的类别放入自由链表
+	//chunk头部之后的偏移都是64的倍数，内存块按64字节对齐
+	template <int inst, class Policy, size_t MaxNodes>
+	void* numa_pool_allocator<inst, Policy, MaxNodes>::mid_alloc(node_pool& pool, size_t node, size_t index)
+	{
+		const size_t size = MID_MIN << index;
+		std::lock_guard<std::mutex> lock(pool.chunk_mutex);
+		if (static_cast<size_t>(pool.mid_end - pool.mid_start) < size) {
+			for (size_t i = index; i-- > 0 && pool.mid_start != pool.mid_end; ) {
+				if (static_cast<size_t>(pool.mid_end - pool.mid_start) >= (MID_MIN << i)) {
+					pool.mid_list[i].push(reinterpret_cast<obj*>(pool.mid_start));
+					pool.mid_start += MID_MIN << i;
+				}
+			}
+			char* chunk = static_cast<char*>(_Numa_os::map(CHUNK_BYTES, CHUNK_BYTES, static_cast<int>(node)));
+			if (nullptr == chunk) { throw std::bad_alloc(); }
+			auto header = reinterpret_cast<chunk_header*>(chunk);
+			header->next = pool.chunk_list;
+			header->node = node;
+			pool.chunk_list = header;
+			pool.mid_start = chunk + sizeof(chunk_header);
+			pool.mid_end = chunk + CHUNK_BYTES;
+			pool.heap_size += CHUNK_BYTES;
+		}
+		char* result = pool.mid_start;
+		pool.mid_start += size;
+		return result;
+	}
+
+	template <int inst, class Policy, size_t MaxNodes>
+	void* numa_pool_allocator<inst, Policy, MaxNodes>::allocate_on(int node, size_t size)
+	{
+		if (0 == size) { return nullptr; }
+		if (size >= static_cast<size_t>(LARGE_BYTES)) {
+			auto header = static_cast<chunk_header*>(
+				_Numa_os::map(large_size(size), _Numa_os::page_size(), node));
+			if (nullptr == header) { throw std::bad_alloc(); }
+			header->next = nullptr;
+			header->node = static_cast<size_t>(node < 0 ? 0 : node);
+			return header + 1;
+		}
+		if (size > static_cast<size_t>(MAX_BYTES)) {
+			const size_t index = pool_index(node);
+			node_pool& pool = pools[index];
+			const size_t mid = mid_index(size);
+			obj* result = pool.mid_list[mid].pop();
+			return nullptr != result ? result : mid_alloc(pool, index, mid);
+		}
+		const size_t index = pool_index(node);
+		node_pool& pool = pools[index];
+		obj* result = pool.free_list[free_list_index(size)].pop();
+		if (nullptr == result) {
+			return refill(pool, index, round_up(size));
+		}
+		return result;
+	}
+
+	template <int inst, class Policy, size_t MaxNodes>
+	void numa_pool_allocator<inst, Policy, MaxNodes>::deallocate(void* p, size_t size)
+	{
+		if (nullptr == p) { return; }
+		chunk_header* header = header_of(p, size);
+		if (size >= static_cast<size_t>(LARGE_BYTES)) {
+			_Numa_os::unmap(header, large_size(size));
+			return;
+		}
+		//由chunk头部找到所属节点，跨节点释放的内存块也归还原节点
+		node_pool& pool = pools[header->node];
+		if (size > static_cast<size_t>(MAX_BYTES)) {
+			pool.mid_list[mid_index(size)].push(static_cast<obj*>(p));
+			return;
+		}
+		pool.free_list[free_list_index(size)].push(static_cast<obj*>(p));
+	}
+
+	template <int inst, class Policy, size_t MaxNodes>
+	void* numa_pool_allocator<inst, Policy, MaxNodes>::
+		reallocate(void* p, size_t old_sz, size_t new_sz)
+	{
+		if (nullptr == p) { return allocate(new_sz); }
+		if (old_sz <= static_cast<size_t>(MAX_BYTES) && new_sz <= static_cast<size_t>(MAX_BYTES) &&
+			round_up(old_sz) == round_up(new_sz)) {
+			return p;
+		}
+		if (old_sz > static_cast<size_t>(MAX_BYTES) && old_sz < static_cast<size_t>(LARGE_BYTES) &&
+			new_sz > static_cast<size_t>(MAX_BYTES) && new_sz < static_cast<size_t>(LARGE_BYTES) &&
+			mid_index(old_sz) == mid_index(new_sz)) {
+			return p;
+		}
+		//新内存块放在原内存块所在的节点上，而不是调用线程所在的节点
+		void* result = allocate_on(static_cast<int>(header_of(p, old_sz)->node), new_sz);
+		std::memcpy(result, p, new_sz > old_sz ? old_sz : new_sz);
+		deallocate(p, old_sz);
+		return result;
+	}
+
+	//把容器固定在某个节点上的分配器，例如
+	//mstd::vector<int, numa_allocator<int>> v(numa_allocator<int>(1));
+	//不同节点的实例可以互相释放对方的内存，因此总是相等，节点随内容一起传播
+	template <class Tp, class NumaAlloc = numa_pool_allocator<0>>
+	class numa_allocator
+	{
+	private:
+		int node_;
+
+		template <class, class> friend class numa_allocator;
+
+	public:
+		using value_type = Tp;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		using is_always_equal = std::true_type;
+
+		template <class Other>
+		struct rebind {
+			using other = numa_allocator<Other, NumaAlloc>;
+		};
+
+		numa_allocator() noexcept : node_(NumaAlloc::current_node()) {}
+		explicit numa_allocator(int node) noexcept : node_(node) {}
+
+		template <class Other>
+		numa_allocator(const numa_allocator<Other, NumaAlloc>& other) noexcept : node_(other.node_) {}
+
+		int node() const noexcept { return node_; }
+
+		Tp* allocate(size_t n) {
+			if (n > static_cast<size_t>(-1) / sizeof(Tp)) { throw std::bad_alloc(); }
+			return static_cast<Tp*>(NumaAlloc::allocate_on(node_, n * sizeof(Tp)));
+		}
+
+		void deallocate(Tp* p, size_t n) noexcept {
+			NumaAlloc::deallocate(p, n * sizeof(Tp));
+		}
+	};
+
+	template <class Tp, class Up, class NumaAlloc>
+	bool operator==(const numa_allocator<Tp, NumaAlloc>&, const numa_allocator<Up, NumaAlloc>&) noexcept {
+		return true;
+	}
+
+	template <class Tp, class Up, class NumaAlloc>
+	bool operator!=(const numa_allocator<Tp, NumaAlloc>&, const numa_allocator<Up, NumaAlloc>&) noexcept {
+		return false;
+	}
+}
@@ -5,11 +5,19 @@ accumulate(); adjacent_difference(); inner_product(); partial_sum(); power(); io
 */
 
 #include "m_functional.h"
+#include "m_utility.h"		// move(); _Is_segmented_iter_v; _Visit_segments();
 
 namespace mstd {
 
 	template<typename IptIter, typename Tp, typename Binary_Operator>
 	Tp accumulate(IptIter first, IptIter last, Tp init, Binary_Operator bin_op) {
+		if constexpr (_Is_segmented_iter_v<IptIter>) {	// 逐块在指针区间上累加，编译器可以向量化
+			_Visit_segments(first, static_cast<size_t>(last - first), [&init, &bin_op](auto ptr, const size_t num) {
+				init = mstd::accumulate(ptr, ptr + num, mstd::move(init), bin_op);
+				return num;
+			});
+			return init;
+		}
 		for (; first != last; ++first) {
 			init = bin_op(init, *first);
 		}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <atomic>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+#include "m_alloc.h"
+
+namespace mstd {
+
+	//大页的使用方式
+	enum class huge_page_mode {
+		off,		// 只用普通页
+		transparent,// 按大页对齐映射并 madvise(MADV_HUGEPAGE)，由内核决定是否合并为透明大页
+		hugetlb		// 先尝试 MAP_HUGETLB 预留的大页，失败再退回 transparent
+	};
+
+	//大块内存直接向系统按页映射，小于 Threshold 的请求交给 malloc_allocator
+	//用于几百MB的 vector，大页可以大幅减少扫描时的 TLB miss，例如
+	//mstd::vector<double, page_allocator<0>> v; v.reserve(size_t(1) << 26);
+	//映射长度按 HUGE_PAGE 取整，deallocate/reallocate 必须传入申请时的大小
+	template <int inst, size_t Threshold = size_t(1) << 21>
+	class page_allocator
+	{
+	private:
+		enum : size_t { HUGE_PAGE = size_t(1) << 21 };	// x86-64/aarch64 默认的2MiB大页
+
+		static std::atomic<huge_page_mode> mode;
+
+		static size_t mapped_size(size_t size) noexcept {
+			return (size + HUGE_PAGE - 1) & ~static_cast<size_t>(HUGE_PAGE - 1);
+		}
+
+		//映射len字节(HUGE_PAGE的整数倍)，失败返回nullptr
+		static void* map(size_t len) noexcept;
+		static void unmap(void* p, size_t len) noexcept;
+
+	public:
+		static void* allocate(size_t size) {
+			if (0 == size) { return nullptr; }
+			if (size < Threshold) { return malloc_allocator<inst>::allocate(size); }
+			void* result = map(mapped_size(size));
+			if (nullptr == result) { throw std::bad_alloc(); }
+			return result;
+		}
+
+		static void* reallocate(void* p, size_t old_sz, size_t new_sz);
+
+		static void deallocate(void* p, size_t size) {
+			if (nullptr == p) { return; }
+			if (size < Threshold) { malloc_allocator<inst>::deallocate(p, size); }
+			else { unmap(p, mapped_size(size)); }
+		}
+
+		//设置之后的映射使用的大页方式，返回原来的方式
+		static huge_page_mode set_huge_page_mode(huge_page_mode m) noexcept {
+			return mode.exchange(m, std::memory_order_relaxed);
+		}
+
+		static huge_page_mode huge_pages() noexcept {
+			return mode.load(std::memory_order_relaxed);
+		}
+	};
+
+	template <int inst, size_t Threshold>
+	std::atomic<huge_page_mode> page_allocator<inst, Threshold>::mode{ huge_page_mode::transparent };
+
+	template <int inst, size_t Threshold>
+	void* page_allocator<inst, Threshold>::map(size_t len) noexcept
+	{
+		const huge_page_mode m = huge_pages();
+#if defined(__linux__)
+		const int prot = PROT_READ | PROT_WRITE;
+		const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_HUGETLB)
+		if (huge_page_mode::hugetlb == m) {
+			void* result = mmap(nullptr, len, prot, flags | MAP_HUGETLB, -1, 0);
+			if (MAP_FAILED != result) { return result; }
+		}
+#endif
+		if (huge_page_mode::off == m) {
+			void* result = mmap(nullptr, len, prot, flags, -1, 0);
+			return MAP_FAILED == result ? nullptr : result;
+		}
+		//多映射一个大页，只保留按大页对齐的部分，透明大页只能作用于对齐的2MiB区间
+		void* raw = mmap(nullptr, len + HUGE_PAGE, prot, flags, -1, 0);
+		if (MAP_FAILED == raw) { return nullptr; }
+		auto first = reinterpret_cast<std::uintptr_t>(raw);
+		auto aligned = (first + HUGE_PAGE - 1) & ~static_cast<std::uintptr_t>(HUGE_PAGE - 1);
+		if (aligned != first) { munmap(raw, aligned - first); }
+		munmap(reinterpret_cast<void*>(aligned + len), HUGE_PAGE - (aligned - first));
+		void* result = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+		madvise(result, len, MADV_HUGEPAGE);	// 内核未开启透明大页时失败，忽略即可
+#endif
+		return result;
+#elif defined(_WIN32)
+		if (huge_page_mode::hugetlb == m) {
+			//大页需要 SeLockMemoryPrivilege 权限，没有权限时失败
+			const SIZE_T large = GetLargePageMinimum();
+			if (0 != large && 0 == len % large) {
+				void* result = VirtualAlloc(nullptr, len, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+				if (nullptr != result) { return result; }
+			}
+		}
+		return VirtualAlloc(nullptr, len, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+		(void)m;
+		return std::malloc(len);
+#endif
+	}
+
+	template <int inst, size_t Threshold>
+	void page_allocator<inst, Threshold>::unmap(void* p, size_t len) noexcept
+	{
+#if defined(__linux__)
+		munmap(p, len);
+#elif defined(_WIN32)
+		(void)len;
+		VirtualFree(p, 0, MEM_RELEASE);
+#else
+		(void)len;
+		std::free(p);
+#endif
+	}
+
+	template <int inst, size_t Threshold>
+	void* page_allocator<inst, Threshold>::reallocate(void* p, size_t old_sz, size_t new_sz)
+	{
+		if (nullptr == p) { return allocate(new_sz); }
+		if (old_sz < Threshold && new_sz < Threshold) {
+			return malloc_allocator<inst>::reallocate(p, old_sz, new_sz);
+		}
+		if (old_sz >= Threshold && new_sz >= Threshold) {
+			const size_t old_len = mapped_size(old_sz);
+			const size_t new_len = mapped_size(new_sz);
+			if (old_len == new_len) { return p; }
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+			//由内核搬移页表，不需要复制数据
+			void* result = mremap(p, old_len, new_len, MREMAP_MAYMOVE);
+			if (MAP_FAILED != result) { return result; }
+#endif
+		}
+		void* result = allocate(new_sz);
+		std::memcpy(result, p, old_sz < new_sz ? old_sz : new_sz);
+		deallocate(p, old_sz);
+		return result;
+	}
+}
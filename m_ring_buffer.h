@@ -0,0 +1,346 @@
+#pragma once
+
+#include <atomic>				// std::atomic<>;
+#include <cstddef>
+#include <cstdint>				// std::intptr_t;
+#include <new>					// placement new;
+#include <type_traits>			// std::is_nothrow_constructible<>;
+
+#include "m_alloc.h"			// malloc_allocator;
+#include "m_memory.h"			// _Container_alloc_t<>; allocator_traits<>;
+#include "m_constructor.h"		// construct(); destroy();
+#include "m_utility.h"			// move(); forward();
+
+namespace mstd {
+
+	// 头尾下标分别放在独立的缓存行上，生产者和消费者不会互相使对方的缓存行失效
+	constexpr size_t _Cache_line_size = 64;
+
+	// 未初始化的元素存储，由环形队列负责构造/析构
+	template<class Tp>
+	struct _Ring_slot {
+		alignas(Tp) unsigned char buf_[sizeof(Tp)];
+
+		Tp* _Ptr() noexcept { return reinterpret_cast<Tp*>(buf_); }
+	};
+
+	// 有界无锁单生产者单消费者环形队列，容量 N 为2的幂
+	// 头尾下标单调递增，用 & (N - 1) 求槽位；双方各自缓存对方的下标，只在看起来满/空时才重新读取
+	// 只允许一个线程调用 push 系列、一个线程调用 pop 系列
+	template<class Tp, size_t N>
+	class spsc_ring
+	{
+	private:
+		static_assert(N >= 2 && 0 == (N & (N - 1)), "spsc_ring capacity must be a power of two.");
+
+		static constexpr size_t _Mask = N - 1;
+
+		alignas(_Cache_line_size) std::atomic<size_t> head_{ 0 };	// 下一个出队位置，消费者写
+		size_t tail_cache_ = 0;										// 消费者看到的 tail_
+		alignas(_Cache_line_size) std::atomic<size_t> tail_{ 0 };	// 下一个入队位置，生产者写
+		size_t head_cache_ = 0;										// 生产者看到的 head_
+		alignas(_Cache_line_size) _Ring_slot<Tp> slots_[N];
+
+		Tp* _Slot(size_t pos) noexcept { return slots_[pos & _Mask]._Ptr(); }
+
+		// 生产者可写入的槽位数，不足 want 时重新读取 head_
+		size_t _Free_slots(size_t tail, size_t want) noexcept {
+			size_t free = N - (tail - head_cache_);
+			if (free < want) {
+				head_cache_ = head_.load(std::memory_order_acquire);
+				free = N - (tail - head_cache_);
+			}
+			return free;
+		}
+
+		// 消费者可读取的元素数，不足 want 时重新读取 tail_
+		size_t _Ready_slots(size_t head, size_t want) noexcept {
+			size_t ready = tail_cache_ - head;
+			if (ready < want) {
+				tail_cache_ = tail_.load(std::memory_order_acquire);
+				ready = tail_cache_ - head;
+			}
+			return ready;
+		}
+
+	public:
+		using value_type = Tp;
+		using size_type = size_t;
+
+		spsc_ring() noexcept = default;
+		spsc_ring(const spsc_ring&) = delete;
+		spsc_ring& operator=(const spsc_ring&) = delete;
+
+		~spsc_ring() {
+			const size_t tail = tail_.load(std::memory_order_relaxed);
+			for (size_t pos = head_.load(std::memory_order_relaxed); pos != tail; ++pos) {
+				mstd::destroy(_Slot(pos));
+			}
+		}
+
+		// 队列满时返回 false
+		template<class... Args>
+		bool try_emplace(Args&&... args) {
+			const size_t tail = tail_.load(std::memory_order_relaxed);
+			if (0 == _Free_slots(tail, 1)) { return false; }
+			mstd::construct(_Slot(tail), mstd::forward<Args>(args)...);
+			tail_.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool try_push(const Tp& val) { return try_emplace(val); }
+		bool try_push(Tp&& val) { return try_emplace(mstd::move(val)); }
+
+		// 从 first 起最多写入 count 个元素，只发布一次 tail_，返回写入个数
+		// 构造抛出异常时已构造的元素照常发布
+		template<class IptIter>
+		size_t push_batch(IptIter first, size_t count) {
+			const size_t tail = tail_.load(std::memory_order_relaxed);
+			const size_t free = _Free_slots(tail, count);
+			const size_t num = count < free ? count : free;
+			size_t done = 0;
+			try {
+				for (; done != num; ++done, ++first) {
+					mstd::construct(_Slot(tail + done), *first);
+				}
+			}
+			catch (...) {
+				tail_.store(tail + done, std::memory_order_release);
+				throw;
+			}
+			tail_.store(tail + num, std::memory_order_release);
+			return num;
+		}
+
+		// 队列空时返回 false
+		bool try_pop(Tp& out) {
+			const size_t head = head_.load(std::memory_order_relaxed);
+			if (0 == _Ready_slots(head, 1)) { return false; }
+			Tp* const ptr = _Slot(head);
+			out = mstd::move(*ptr);
+			mstd::destroy(ptr);
+			head_.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		// 最多取出 max_count 个元素移动到 dest，只发布一次 head_，返回取出个数
+		// 移动赋值抛出异常时，已取出的元素照常发布，抛出异常的元素留在队列中
+		template<class OptIter>
+		size_t pop_batch(OptIter dest, size_t max_count) {
+			const size_t head = head_.load(std::memory_order_relaxed);
+			const size_t ready = _Ready_slots(head, max_count);
+			const size_t num = max_count < ready ? max_count : ready;
+			size_t done = 0;
+			try {
+				for (; done != num; ++done, ++dest) {
+					Tp* const ptr = _Slot(head + done);
+					*dest = mstd::move(*ptr);
+					mstd::destroy(ptr);
+				}
+			}
+			catch (...) {
+				head_.store(head + done, std::memory_order_release);
+				throw;
+			}
+			head_.store(head + num, std::memory_order_release);
+			return num;
+		}
+
+		// 其他线程同时读写时只是近似值
+		size_t size() const noexcept {
+			return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+		}
+
+		bool empty() const noexcept { return 0 == size(); }
+
+		static constexpr size_t capacity() noexcept { return N; }
+	};
+
+	// 有界无锁多生产者多消费者环形队列(Dmitry Vyukov 的算法)，容量在构造时向上取为2的幂
+	// 每个槽位带一个序号：seq == pos 表示可写入，seq == pos + 1 表示可读取，
+	// 读出后置为 pos + 容量，供下一圈写入。生产者和消费者各自只在一个下标上 CAS
+	template<class Tp, class Alloc = malloc_allocator<0>>
+	class mpmc_ring
+	{
+	private:
+		static_assert(std::is_nothrow_move_constructible<Tp>::value, "mpmc_ring requires a nothrow move constructible element type.");
+
+		struct _Cell {
+			std::atomic<size_t> seq_;
+			_Ring_slot<Tp> slot_;
+		};
+
+		using _Alcell = _Container_alloc_t<Alloc, _Cell>;
+		using _Alcell_traits = allocator_traits<_Alcell>;
+
+		_Alcell alloc_;
+		_Cell* cells_ = nullptr;
+		size_t mask_ = 0;
+		alignas(_Cache_line_size) std::atomic<size_t> enqueue_pos_{ 0 };
+		alignas(_Cache_line_size) std::atomic<size_t> dequeue_pos_{ 0 };	// 类按缓存行对齐，后面的对象不会与它共享缓存行
+
+		static std::intptr_t _Diff(size_t seq, size_t pos) noexcept {
+			return static_cast<std::intptr_t>(seq - pos);
+		}
+
+		// 从 enqueue_pos_ 起占用最多 count 个连续的可写槽位，返回起始位置和个数
+		size_t _Claim_enqueue(size_t count, size_t& pos) noexcept {
+			if (0 == count) { return 0; }
+			pos = enqueue_pos_.load(std::memory_order_relaxed);
+			for (;;) {
+				size_t num = 0;
+				while (num != count && 0 == _Diff(cells_[(pos + num) & mask_].seq_.load(std::memory_order_acquire), pos + num)) {
+					++num;
+				}
+				if (0 == num) {
+					// 槽位序号落后说明队列已满；超前说明 pos 已被其他生产者占用，重新读取
+					if (_Diff(cells_[pos & mask_].seq_.load(std::memory_order_acquire), pos) < 0) { return 0; }
+					pos = enqueue_pos_.load(std::memory_order_relaxed);
+				}
+				else if (enqueue_pos_.compare_exchange_weak(pos, pos + num, std::memory_order_relaxed)) {
+					return num;
+				}
+			}
+		}
+
+		// 从 dequeue_pos_ 起占用最多 count 个连续的可读槽位
+		size_t _Claim_dequeue(size_t count, size_t& pos) noexcept {
+			if (0 == count) { return 0; }
+			pos = dequeue_pos_.load(std::memory_order_relaxed);
+			for (;;) {
+				size_t num = 0;
+				while (num != count && 0 == _Diff(cells_[(pos + num) & mask_].seq_.load(std::memory_order_acquire), pos + num + 1)) {
+					++num;
+				}
+				if (0 == num) {
+					if (_Diff(cells_[pos & mask_].seq_.load(std::memory_order_acquire), pos + 1) < 0) { return 0; }
+					pos = dequeue_pos_.load(std::memory_order_relaxed);
+				}
+				else if (dequeue_pos_.compare_exchange_weak(pos, pos + num, std::memory_order_relaxed)) {
+					return num;
+				}
+			}
+		}
+
+		// 取出元素后析构并把槽位交还生产者，移动赋值抛出异常时同样交还
+		struct _Release_cell {
+			_Cell* cell_;
+			size_t next_seq_;
+
+			~_Release_cell() {
+				mstd::destroy(cell_->slot_._Ptr());
+				cell_->seq_.store(next_seq_, std::memory_order_release);
+			}
+		};
+
+	public:
+		using value_type = Tp;
+		using size_type = size_t;
+		using allocator_type = _Alcell;
+
+		explicit mpmc_ring(size_t capacity, const allocator_type& alloc = allocator_type())
+			: alloc_(alloc) {
+			size_t size = 2;
+			while (size < capacity) { size *= 2; }
+			cells_ = _Alcell_traits::allocate(alloc_, size);
+			for (size_t i = 0; i != size; ++i) {
+				mstd::construct(cells_ + i);
+				cells_[i].seq_.store(i, std::memory_order_relaxed);
+			}
+			mask_ = size - 1;
+		}
+
+		mpmc_ring(const mpmc_ring&) = delete;
+		mpmc_ring& operator=(const mpmc_ring&) = delete;
+
+		// 析构时不能有其他线程访问队列
+		~mpmc_ring() {
+			const size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+			for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != tail; ++pos) {
+				mstd::destroy(cells_[pos & mask_].slot_._Ptr());
+			}
+			for (size_t i = 0; i <= mask_; ++i) {
+				mstd::destroy(cells_ + i);
+			}
+			_Alcell_traits::deallocate(alloc_, cells_, mask_ + 1);
+		}
+
+		// 队列满时返回 false
+		template<class... Args>
+		bool try_emplace(Args&&... args) {
+			if constexpr (!std::is_nothrow_constructible<Tp, Args&&...>::value) {
+				// 先在槽位外构造：占用槽位后再抛出异常，该槽位将永远不能被读取
+				Tp temp(mstd::forward<Args>(args)...);
+				return try_emplace(mstd::move(temp));
+			}
+			else {
+				size_t pos = 0;
+				if (0 == _Claim_enqueue(1, pos)) { return false; }
+				_Cell& cell = cells_[pos & mask_];
+				mstd::construct(cell.slot_._Ptr(), mstd::forward<Args>(args)...);
+				cell.seq_.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+
+		bool try_push(const Tp& val) { return try_emplace(val); }
+		bool try_push(Tp&& val) { return try_emplace(mstd::move(val)); }
+
+		// 从 first 起最多写入 count 个元素，一次 CAS 占用连续的槽位，返回写入个数
+		template<class IptIter>
+		size_t push_batch(IptIter first, size_t count) {
+			if constexpr (!std::is_nothrow_constructible<Tp, decltype(*first)>::value) {
+				size_t done = 0;
+				for (; done != count && try_emplace(*first); ++done, ++first) {}
+				return done;
+			}
+			else {
+				size_t pos = 0;
+				const size_t num = _Claim_enqueue(count, pos);
+				for (size_t i = 0; i != num; ++i, ++first) {
+					_Cell& cell = cells_[(pos + i) & mask_];
+					mstd::construct(cell.slot_._Ptr(), *first);
+					cell.seq_.store(pos + i + 1, std::memory_order_release);
+				}
+				return num;
+			}
+		}
+
+		// 队列空时返回 false
+		bool try_pop(Tp& out) { return 1 == pop_batch(&out, 1); }
+
+		// 最多取出 max_count 个元素移动到 dest，一次 CAS 占用连续的槽位，返回取出个数
+		// 移动赋值抛出异常时，本批次剩余的元素被丢弃，槽位仍交还生产者
+		template<class OptIter>
+		size_t pop_batch(OptIter dest, size_t max_count) {
+			size_t pos = 0;
+			const size_t num = _Claim_dequeue(max_count, pos);
+			size_t i = 0;
+			try {
+				for (; i != num; ++i, ++dest) {
+					_Release_cell guard{ &cells_[(pos + i) & mask_], pos + i + mask_ + 1 };
+					*dest = mstd::move(*guard.cell_->slot_._Ptr());
+				}
+			}
+			catch (...) {
+				for (++i; i != num; ++i) {
+					_Release_cell guard{ &cells_[(pos + i) & mask_], pos + i + mask_ + 1 };
+				}
+				throw;
+			}
+			return num;
+		}
+
+		// 其他线程同时读写时只是近似值
+		size_t size() const noexcept {
+			const size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+			const size_t head = dequeue_pos_.load(std::memory_order_acquire);
+			return tail - head <= mask_ + 1 ? tail - head : 0;
+		}
+
+		bool empty() const noexcept { return 0 == size(); }
+
+		size_t capacity() const noexcept { return mask_ + 1; }
+	};
+
+}
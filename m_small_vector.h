@@ -0,0 +1,604 @@
+#pragma once
+
+#include <initializer_list>		// std::initialized_list;
+#include <exception>			// std::out_of_range;
+#include <cstring>				// std::memmove();
+#include <type_traits>			// std::enable_if_t<>;
+
+#include "m_alloc.h"			// malloc_allocator;
+#include "m_memory.h"			// allocator_traits; _Compressed_pair; _Uninitialized_relocate();
+#include "m_utility.h"			// is_iterator_v<>;
+#include "m_algorithm.h"		// equal(); lexicographical_compare();
+#include "m_iterator.h"			// reverse_iterator; _MSTD_HARDENED_CHECK();
+#include "m_vector.h"			// _vector_iterator;
+
+namespace mstd {
+
+	// 前N个元素放在对象内部的缓冲区，超出后转移到堆上，接口与 vector 相同
+	// 内部缓冲区中的元素不能被其他对象接管，移动构造/移动赋值/swap 需要逐个搬移元素
+	template<typename Tp, size_t N, typename Alloc = malloc_allocator<0>>
+	class small_vector {
+	private:
+		using _Alty = _Container_alloc_t<Alloc, Tp>;
+		using _Alty_traits = allocator_traits<_Alty>;
+
+	public:
+		static_assert(N > 0, "small_vector needs at least one inline element.");
+		static_assert(mstd::is_same_v<typename _Alty_traits::pointer, Tp*>,
+			"small_vector does not support allocators with fancy pointers.");
+
+		using data_allocator = Alloc;
+		using allocator_type = _Alty;
+		using value_type = Tp;
+		using pointer = value_type*;
+		using reference = value_type&;
+		using const_pointer = const value_type*;
+		using const_reference = const value_type&;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+
+		using iterator = _vector_iterator<small_vector>;
+		using const_iterator = _vector_const_iterator<small_vector>;
+		using reverse_iterator = mstd::reverse_iterator<iterator>;
+		using const_reverse_iterator = mstd::reverse_iterator<const_iterator>;
+
+		static constexpr size_type inline_capacity = N;
+
+	protected:
+		struct _Small_vector_val {
+			pointer first_{};
+			pointer last_{};
+			pointer end_{};
+			alignas(Tp) unsigned char buf_[N * sizeof(Tp)];
+		};
+
+		_Compressed_pair<_Alty, _Small_vector_val> m_pair_;
+
+		_Alty& _Get_alloc() noexcept { return m_pair_._Get_first(); }
+		const _Alty& _Get_alloc() const noexcept { return m_pair_._Get_first(); }
+
+		pointer& _Myfirst() noexcept { return m_pair_.second_.first_; }
+		const pointer& _Myfirst() const noexcept { return m_pair_.second_.first_; }
+		pointer& _Mylast() noexcept { return m_pair_.second_.last_; }
+		const pointer& _Mylast() const noexcept { return m_pair_.second_.last_; }
+		pointer& _Myend() noexcept { return m_pair_.second_.end_; }
+		const pointer& _Myend() const noexcept { return m_pair_.second_.end_; }
+
+		pointer _Mybuf() noexcept { return reinterpret_cast<pointer>(m_pair_.second_.buf_); }
+		const_pointer _Mybuf() const noexcept { return reinterpret_cast<const_pointer>(m_pair_.second_.buf_); }
+
+		static constexpr bool _Use_relocate = is_trivially_relocatable_v<value_type>;
+
+		// 指向内部缓冲区，不持有堆内存
+		void reset_inline() noexcept {
+			_Myfirst() = _Mylast() = _Mybuf();
+			_Myend() = _Mybuf() + N;
+		}
+
+		// 销毁全部元素，归还堆内存并回到内部缓冲区
+		void _Tidy() noexcept {
+			_Destroy_range(_Myfirst(), _Mylast(), _Get_alloc());
+			if (!is_inline()) {
+				_Alty_traits::deallocate(_Get_alloc(), _Myfirst(), capacity());
+			}
+			reset_inline();
+		}
+
+		// 把元素搬到new_first开始的new_cap个元素的空间，new_first为内部缓冲区时不分配
+		void relocate_to(pointer new_first, size_type new_cap) {
+			const size_type old_size = size();
+			_Uninitialized_relocate(_Myfirst(), _Mylast(), new_first, _Get_alloc());
+			if (!is_inline()) {
+				_Alty_traits::deallocate(_Get_alloc(), _Myfirst(), capacity());
+			}
+			_Myfirst() = new_first;
+			_Mylast() = new_first + old_size;
+			_Myend() = new_first + new_cap;
+		}
+
+		// 在堆上重新分配new_cap个元素的空间并搬入原有元素，原迭代器失效
+		void reallocate_n(size_type new_cap) {
+			pointer new_first = _Alty_traits::allocate(_Get_alloc(), new_cap);
+			try {
+				relocate_to(new_first, new_cap);
+			}
+			catch (...) {
+				_Alty_traits::deallocate(_Get_alloc(), new_first, new_cap);
+				throw;
+			}
+		}
+
+		//请求n个元素的空间，若剩余空间不足则分配新的内存，原迭代器可能失效
+		void check_and_alloc(size_type n) {
+			if (_Myend() - _Mylast() >= static_cast<difference_type>(n)) { return; }
+			reallocate_n(vector_growth_2x::next_capacity(capacity(), size() + n, sizeof(value_type)));
+		}
+
+		//将[pos，finish)之间的元素向前移动n个位置
+		void move_forward_n(pointer pos, size_type n) {
+			pointer dest = pos - n;
+			if constexpr (_Use_relocate) {
+				_Destroy_range(dest, pos, _Get_alloc());
+				std::memmove(static_cast<void*>(dest), static_cast<const void*>(pos),
+					(_Mylast() - pos) * sizeof(value_type));
+				_Mylast() -= n;
+			}
+			else {
+				pointer new_finish = mstd::move(pos, _Mylast(), dest);
+				_Destroy_range(new_finish, _Mylast(), _Get_alloc());
+				_Mylast() = new_finish;
+			}
+		}
+
+		//将[pos,finish)之间的元素向后移动n个位置，finish_后移n个位置，[pos, pos + n)留给调用者构造
+		void move_backward_n(pointer pos, size_type n) {
+			_Alty& al = _Get_alloc();
+			pointer new_finish = _Mylast() + n;
+			pointer new_pos = pos + n;
+			if constexpr (_Use_relocate) {
+				std::memmove(static_cast<void*>(new_pos), static_cast<const void*>(pos),
+					(_Mylast() - pos) * sizeof(value_type));
+			}
+			else {
+				pointer src = _Mylast(), dst = new_finish;
+				if (new_pos < _Mylast()) {
+					while (dst != _Mylast()) {
+						_Alty_traits::construct(al, --dst, std::move(*--src));
+					}
+					while (dst != new_pos) {
+						*--dst = std::move(*--src);
+					}
+					_Destroy_range(pos, new_pos, al);
+				}
+				else {
+					while (dst != new_pos) {
+						_Alty_traits::construct(al, --dst, std::move(*--src));
+					}
+					_Destroy_range(pos, _Mylast(), al);
+				}
+			}
+			_Mylast() = new_finish;
+		}
+
+		// 接管other的元素，other的元素在堆上时直接接管内存，否则逐个搬到内部缓冲区，不涉及分配器
+		void take_over(small_vector& other) {
+			if (other.is_inline()) {
+				_Mylast() = _Uninitialized_relocate(other._Myfirst(), other._Mylast(), _Myfirst(), _Get_alloc());
+				other._Mylast() = other._Myfirst();
+			}
+			else {
+				_Myfirst() = other._Myfirst();
+				_Mylast() = other._Mylast();
+				_Myend() = other._Myend();
+				other.reset_inline();
+			}
+		}
+
+		// 分配器不相等时逐个移动元素，other保留自己的内存
+		void move_elements(small_vector& other) {
+			reserve(other.size());
+			_Mylast() = _Uninitialized_move(other._Myfirst(), other._Mylast(), _Myfirst(), _Get_alloc());
+			other.clear();
+		}
+
+		template <typename IptIter>
+		void range_init(IptIter first, IptIter last) {
+			const auto n = static_cast<size_type>(std::distance(first, last));
+			reserve(n);
+			try {
+				_Mylast() = _Uninitialized_copy(first, last, _Myfirst(), _Get_alloc());
+			}
+			catch (...) {
+				_Tidy();
+				throw;
+			}
+		}
+
+		void fill_init(size_type n, const value_type& value) {
+			reserve(n);
+			try {
+				_Mylast() = _Uninitialized_fill_n(_Myfirst(), n, value, _Get_alloc());
+			}
+			catch (...) {
+				_Tidy();
+				throw;
+			}
+		}
+
+		bool is_invalid_index(size_type index) const noexcept {
+			return index >= size();
+		}
+
+		bool is_invalid_iterator(const_iterator pos) const noexcept {
+			return pos.raw_ptr() < _Myfirst() || pos.raw_ptr() >= _Mylast();
+		}
+
+		bool is_invalid_insert_iterator(const_iterator pos) const noexcept {
+			return pos.raw_ptr() < _Myfirst() || pos.raw_ptr() > _Mylast();
+		}
+
+	public:
+		small_vector() noexcept(mstd::is_nothrow_default_constructible<_Alty>::value)
+			: m_pair_(_Zero_then_variadic_args_t{}) {
+			reset_inline();
+		}
+		explicit small_vector(const allocator_type& alloc) noexcept
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			reset_inline();
+		}
+		explicit small_vector(size_type size, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			reset_inline();
+			fill_init(size, value_type());
+		}
+		small_vector(size_type size, const value_type& value, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			reset_inline();
+			fill_init(size, value);
+		}
+		template <typename IptIter, std::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
+		small_vector(IptIter first, IptIter last, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			reset_inline();
+			range_init(first, last);
+		}
+		small_vector(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			reset_inline();
+			range_init(ilist.begin(), ilist.end());
+		}
+		small_vector(const small_vector& other)
+			: m_pair_(_One_then_variadic_args_t{}, _Alty_traits::select_on_container_copy_construction(other._Get_alloc())) {
+			reset_inline();
+			range_init(other._Myfirst(), other._Mylast());
+		}
+		small_vector(const small_vector& other, const allocator_type& alloc)
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			reset_inline();
+			range_init(other._Myfirst(), other._Mylast());
+		}
+		small_vector(small_vector&& other) noexcept(mstd::is_nothrow_move_constructible<value_type>::value)
+			: m_pair_(_One_then_variadic_args_t{}, std::move(other._Get_alloc())) {
+			reset_inline();
+			take_over(other);
+		}
+		small_vector(small_vector&& other, const allocator_type& alloc)
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			reset_inline();
+			if constexpr (!_Alty_traits::is_always_equal::value) {
+				if (_Get_alloc() != other._Get_alloc()) {
+					move_elements(other);
+					return;
+				}
+			}
+			take_over(other);
+		}
+		small_vector& operator=(const small_vector& other) {
+			if (this == &other) { return *this; }
+			if constexpr (_Choose_pocca_v<_Alty>) {
+				if (_Get_alloc() != other._Get_alloc()) { _Tidy(); }
+			}
+			_Pocca(_Get_alloc(), other._Get_alloc());
+			assign(other._Myfirst(), other._Mylast());
+			return *this;
+		}
+		small_vector& operator=(small_vector&& other)
+			noexcept(_Choose_pocma_v<_Alty> != _Pocma_values::_No_propagate_allocators
+				&& mstd::is_nothrow_move_constructible<value_type>::value) {
+			if (this == &other) { return *this; }
+			if constexpr (_Choose_pocma_v<_Alty> == _Pocma_values::_No_propagate_allocators) {
+				if (_Get_alloc() != other._Get_alloc()) {
+					clear();
+					move_elements(other);
+					return *this;
+				}
+			}
+			_Tidy();
+			_Pocma(_Get_alloc(), other._Get_alloc());
+			take_over(other);
+			return *this;
+		}
+		small_vector& operator=(std::initializer_list<value_type> ilist) {
+			assign(ilist.begin(), ilist.end());
+			return *this;
+		}
+		~small_vector() { _Tidy(); }
+
+	public:
+		iterator begin() noexcept { return _Myfirst(); }
+		iterator end() noexcept { return _Mylast(); }
+		const_iterator begin() const noexcept { return _Myfirst(); }
+		const_iterator end() const  noexcept { return _Mylast(); }
+		const_iterator cbegin() const noexcept { return _Myfirst(); }
+		const_iterator cend() const  noexcept { return _Mylast(); }
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+		allocator_type get_allocator() const noexcept { return _Get_alloc(); }
+
+		reference at(size_type index) {
+			if (is_invalid_index(index)) {
+				throw std::out_of_range
+				{ "small_vector member func at() error: index out of range" };
+			}
+			return _Myfirst()[index];
+		}
+		const_reference at(size_type index) const {
+			if (is_invalid_index(index)) {
+				throw std::out_of_range
+				{ "small_vector member func at() error: index out of range" };
+			}
+			return _Myfirst()[index];
+		}
+		reference front() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "front() called on empty small_vector");
+			return *_Myfirst();
+		}
+		const_reference front() const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "front() called on empty small_vector");
+			return *_Myfirst();
+		}
+		reference back() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "back() called on empty small_vector");
+			return *(_Mylast() - 1);
+		}
+		const_reference back() const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "back() called on empty small_vector");
+			return *(_Mylast() - 1);
+		}
+		size_type size() const noexcept { return size_type(_Mylast() - _Myfirst()); }
+		size_type capacity() const noexcept { return size_type(_Myend() - _Myfirst()); }
+		size_type max_size() const noexcept { return _Alty_traits::max_size(_Get_alloc()); }
+		bool empty() const noexcept { return _Myfirst() == _Mylast(); }
+
+		// 元素是否还在内部缓冲区中
+		bool is_inline() const noexcept { return _Myfirst() == _Mybuf(); }
+
+		template<typename IptIter, std::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
+		void assign(IptIter first, IptIter last) {
+			clear();
+			const auto n = static_cast<size_type>(std::distance(first, last));
+			reserve(n);
+			_Mylast() = _Uninitialized_copy(first, last, _Myfirst(), _Get_alloc());
+		}
+
+		void assign(std::initializer_list<value_type> ilist) {
+			assign(ilist.begin(), ilist.end());
+		}
+
+		void assign(size_type size, const value_type& value) {
+			clear();
+			reserve(size);
+			_Mylast() = _Uninitialized_fill_n(_Myfirst(), size, value, _Get_alloc());
+		}
+
+		void push_back(const value_type& val) {
+			emplace_back(val);
+		}
+
+		void push_back(value_type&& val) {
+			emplace_back(std::move(val));
+		}
+
+		void pop_back() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "pop_back() called on empty small_vector");
+			_Alty_traits::destroy(_Get_alloc(), --_Mylast());
+		}
+
+		template <typename... Args>
+		iterator emplace(const_iterator pos, Args&&... args) {
+			_MSTD_HARDENED_CHECK(!is_invalid_insert_iterator(pos),
+				"small_vector member func emplace() error: iterator out of range");
+			const difference_type index = pos.raw_ptr() - _Myfirst();
+			if (pos.raw_ptr() == _Mylast() && _Mylast() != _Myend()) {
+				_Alty_traits::construct(_Get_alloc(), _Mylast(), std::forward<Args>(args)...);
+				return _Mylast()++;
+			}
+			value_type temp(std::forward<Args>(args)...);	// 参数可能引用本容器中的元素，先构造再搬移
+			check_and_alloc(1);
+			pointer new_pos = _Myfirst() + index;
+			move_backward_n(new_pos, 1);
+			_Alty_traits::construct(_Get_alloc(), new_pos, std::move(temp));
+			return new_pos;
+		}
+
+		template <typename... Args>
+		reference emplace_back(Args&&... args) {
+			return *emplace(cend(), std::forward<Args>(args)...);
+		}
+
+		iterator erase(const_iterator pos) {
+			_MSTD_HARDENED_CHECK(!is_invalid_iterator(pos),
+				"small_vector member func erase() error: iterator out of range");
+			move_forward_n(pos.raw_ptr() + 1, 1);
+			return pos.raw_ptr();
+		}
+
+		iterator erase(const_iterator first, const_iterator last) {
+			_MSTD_HARDENED_CHECK(!(is_invalid_insert_iterator(first) || is_invalid_insert_iterator(last) || last < first),
+				"small_vector member func erase() error: iterator out of range");
+			if (first != last) {
+				move_forward_n(last.raw_ptr(), static_cast<size_type>(last - first));
+			}
+			return first.raw_ptr();
+		}
+
+		iterator insert(const_iterator pos, const value_type& val) {
+			return emplace(pos, val);
+		}
+
+		iterator insert(const_iterator pos, value_type&& val) {
+			return emplace(pos, std::move(val));
+		}
+
+		iterator insert(const_iterator pos, size_type num, const value_type& value) {
+			_MSTD_HARDENED_CHECK(!is_invalid_insert_iterator(pos),
+				"small_vector member func insert() error: iterator out of range");
+			const difference_type index = pos.raw_ptr() - _Myfirst();
+			if (0 == num) { return _Myfirst() + index; }
+			value_type temp(value);
+			check_and_alloc(num);
+			pointer new_pos = _Myfirst() + index;
+			move_backward_n(new_pos, num);
+			_Uninitialized_fill_n(new_pos, num, temp, _Get_alloc());
+			return new_pos;
+		}
+
+		template<typename IptIter, std::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
+		iterator insert(const_iterator pos, IptIter first, IptIter last) {
+			_MSTD_HARDENED_CHECK(!is_invalid_insert_iterator(pos),
+				"small_vector member func insert() error: iterator out of range");
+			const auto num = static_cast<size_type>(std::distance(first, last));
+			const difference_type index = pos.raw_ptr() - _Myfirst();
+			check_and_alloc(num);
+			pointer new_pos = _Myfirst() + index;
+			move_backward_n(new_pos, num);
+			_Uninitialized_copy(first, last, new_pos, _Get_alloc());
+			return new_pos;
+		}
+
+		iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
+			return insert(pos, ilist.begin(), ilist.end());
+		}
+
+		Tp* data() noexcept { return _Myfirst(); }
+
+		const Tp* data() const noexcept { return _Myfirst(); }
+
+		void resize(size_type new_sz) {
+			if (new_sz > size()) {
+				check_and_alloc(new_sz - size());
+				_Mylast() = _Uninitialized_value_construct_n(_Mylast(), new_sz - size(), _Get_alloc());
+			}
+			else {
+				_Destroy_range(_Myfirst() + new_sz, _Mylast(), _Get_alloc());
+				_Mylast() = _Myfirst() + new_sz;
+			}
+		}
+
+		// 新增的元素只做默认初始化，平凡类型不清零，由调用者随后写入(例如 read()、解码器)
+		void resize_default_init(size_type new_sz) {
+			if (new_sz > size()) {
+				uninitialized_append(new_sz - size());
+			}
+			else {
+				resize(new_sz);
+			}
+		}
+
+		void resize_for_overwrite(size_type new_sz) {
+			resize_default_init(new_sz);
+		}
+
+		// 在末尾追加n个默认初始化的元素，返回第一个新元素的地址
+		pointer uninitialized_append(size_type n) {
+			check_and_alloc(n);
+			pointer result = _Mylast();
+			_Mylast() = _Uninitialized_default_construct_n(result, n, _Get_alloc());
+			return result;
+		}
+
+		void resize(size_type new_sz, const value_type& value) {
+			if (new_sz > size()) {
+				check_and_alloc(new_sz - size());
+				_Mylast() = _Uninitialized_fill_n(_Mylast(), new_sz - size(), value, _Get_alloc());
+			}
+			else {
+				_Destroy_range(_Myfirst() + new_sz, _Mylast(), _Get_alloc());
+				_Mylast() = _Myfirst() + new_sz;
+			}
+		}
+
+		void reserve(size_type new_capacity) {
+			if (new_capacity > capacity()) {
+				reallocate_n(new_capacity);
+			}
+		}
+
+		void clear() noexcept {
+			_Destroy_range(_Myfirst(), _Mylast(), _Get_alloc());
+			_Mylast() = _Myfirst();
+		}
+
+		// 元素个数不超过N时搬回内部缓冲区
+		void shrink_to_fit() {
+			if (is_inline() || size() == capacity()) { return; }
+			if (size() <= N) {
+				relocate_to(_Mybuf(), N);
+			}
+			else {
+				reallocate_n(size());
+			}
+		}
+
+		reference operator[](size_type index) noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(index < size(), "small_vector subscript out of range");
+			return _Myfirst()[index];
+		}
+
+		const_reference operator[](size_type index) const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(index < size(), "small_vector subscript out of range");
+			return _Myfirst()[index];
+		}
+
+		// 内部缓冲区不能交换指针，借助一个临时对象完成三次移动
+		void swap(small_vector& right) {
+			if (this != &right) {
+				_Pocs(_Get_alloc(), right._Get_alloc());
+				small_vector temp(_One_then_variadic_args_t{}, _Get_alloc());
+				temp.take_over(*this);
+				take_over(right);
+				right.take_over(temp);
+			}
+		}
+
+	private:
+		// swap 使用的空对象
+		small_vector(_One_then_variadic_args_t, const allocator_type& alloc) noexcept
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			reset_inline();
+		}
+	};
+
+	template<typename Tp, size_t N, typename Alloc>
+	inline void swap(small_vector<Tp, N, Alloc>& left, small_vector<Tp, N, Alloc>& right) {
+		left.swap(right);
+	}
+
+	template<typename Tp, size_t N, typename Alloc>
+	inline bool operator==(const small_vector<Tp, N, Alloc>& left, const small_vector<Tp, N, Alloc>& right) {
+		return left.size() == right.size() && mstd::equal(left.begin(), left.end(), right.begin());
+	}
+
+	template<typename Tp, size_t N, typename Alloc>
+	inline bool operator!=(const small_vector<Tp, N, Alloc>& left, const small_vector<Tp, N, Alloc>& right) {
+		return !(left == right);
+	}
+
+	template<typename Tp, size_t N, typename Alloc>
+	inline bool operator<(const small_vector<Tp, N, Alloc>& left, const small_vector<Tp, N, Alloc>& right) {
+		return mstd::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end());
+	}
+
+	template<typename Tp, size_t N, typename Alloc>
+	inline bool operator>(const small_vector<Tp, N, Alloc>& left, const small_vector<Tp, N, Alloc>& right) {
+		return right < left;
+	}
+
+	template<typename Tp, size_t N, typename Alloc>
+	inline bool operator<=(const small_vector<Tp, N, Alloc>& left, const small_vector<Tp, N, Alloc>& right) {
+		return !(right < left);
+	}
+
+	template<typename Tp, size_t N, typename Alloc>
+	inline bool operator>=(const small_vector<Tp, N, Alloc>& left, const small_vector<Tp, N, Alloc>& right) {
+		return !(left < right);
+	}
+
+	namespace pmr {
+		template<class Tp, size_t N>
+		using small_vector = mstd::small_vector<Tp, N, polymorphic_allocator<Tp>>;
+	}
+}
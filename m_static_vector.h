@@ -0,0 +1,467 @@
+#pragma once
+
+#include <initializer_list>		// std::initialized_list;
+#include <exception>			// std::out_of_range;
+#include <new>					// std::bad_alloc; placement new;
+#include <type_traits>			// std::enable_if_t<>;
+
+#include "m_type_traits.h"		// is_trivially_copyable<>;
+#include "m_utility.h"			// is_iterator_v<>;
+#include "m_iterator.h"			// reverse_iterator; _MSTD_HARDENED_CHECK();
+#include "m_algorithm.h"		// rotate();
+
+namespace mstd {
+
+	// static_vector 的存储：平凡类型直接用数组，可以在常量表达式中使用(C++20起允许不初始化)
+	// 其他类型使用未初始化的字节缓冲区，构造/析构由存储负责
+	template<class Tp, size_t N, bool = is_trivially_copyable<Tp>::value
+		&& is_trivially_default_constructible<Tp>::value && is_trivially_destructible<Tp>::value>
+	struct _Static_vector_storage {
+		Tp elems_[N];
+		size_t size_ = 0;
+
+		constexpr _Static_vector_storage() noexcept {}
+
+		constexpr Tp* _Data() noexcept { return elems_; }
+		constexpr const Tp* _Data() const noexcept { return elems_; }
+
+		template<class... Args>
+		constexpr void _Construct_at(Tp* p, Args&&... args) {
+			*p = Tp(mstd::forward<Args>(args)...);
+		}
+
+		constexpr void _Destroy_range(Tp*, Tp*) noexcept {}
+
+		// 在末尾构造 count 个元素，make(p) 在 p 处构造一个元素；全部构造完才更新 size_
+		template<class Fn>
+		constexpr void _Append_n(size_t count, Fn make) {
+			size_t n = size_;
+			for (; n != size_ + count; ++n) { make(_Data() + n); }
+			size_ = n;
+		}
+	};
+
+	template<class Tp, size_t N>
+	struct _Static_vector_storage<Tp, N, false> {
+		alignas(Tp) unsigned char buf_[N * sizeof(Tp)];
+		size_t size_ = 0;
+
+		_Static_vector_storage() noexcept {}
+
+		_Static_vector_storage(const _Static_vector_storage& other) {
+			_Construct_n(other._Data(), other.size_);
+		}
+
+		_Static_vector_storage(_Static_vector_storage&& other) noexcept(is_nothrow_move_constructible<Tp>::value) {
+			_Construct_n(mstd::move_iterator<Tp*>(other._Data()), other.size_);
+		}
+
+		_Static_vector_storage& operator=(const _Static_vector_storage& other) {
+			if (this != &other) { _Assign(other._Data(), other.size_); }
+			return *this;
+		}
+
+		_Static_vector_storage& operator=(_Static_vector_storage&& other) {
+			if (this != &other) { _Assign(mstd::move_iterator<Tp*>(other._Data()), other.size_); }
+			return *this;
+		}
+
+		~_Static_vector_storage() { _Destroy_range(_Data(), _Data() + size_); }
+
+		Tp* _Data() noexcept { return reinterpret_cast<Tp*>(buf_); }
+		const Tp* _Data() const noexcept { return reinterpret_cast<const Tp*>(buf_); }
+
+		template<class... Args>
+		void _Construct_at(Tp* p, Args&&... args) {
+			::new (static_cast<void*>(p)) Tp(mstd::forward<Args>(args)...);
+		}
+
+		void _Destroy_range(Tp* first, Tp* last) noexcept {
+			for (; first != last; ++first) { first->~Tp(); }
+		}
+
+		// 拷贝/移动构造使用：中途抛出异常时析构函数不会执行，需要自行销毁已构造的元素
+		template<class Iter>
+		void _Construct_n(Iter src, size_t count) {
+			try {
+				for (; size_ != count; ++size_, ++src) { _Construct_at(_Data() + size_, *src); }
+			}
+			catch (...) {
+				_Destroy_range(_Data(), _Data() + size_);
+				throw;
+			}
+		}
+
+		// 在末尾构造 count 个元素，make(p) 在 p 处构造一个元素；中途抛出异常时销毁本次构造的元素，size_ 不变
+		template<class Fn>
+		void _Append_n(size_t count, Fn make) {
+			const size_t old_size = size_;
+			try {
+				for (; size_ != old_size + count; ++size_) { make(_Data() + size_); }
+			}
+			catch (...) {
+				_Destroy_range(_Data() + old_size, _Data() + size_);
+				size_ = old_size;
+				throw;
+			}
+		}
+
+		// 前面的元素赋值，多出的部分构造或销毁
+		template<class Iter>
+		void _Assign(Iter src, size_t count) {
+			size_t i = 0;
+			for (; i != count && i != size_; ++i, ++src) { _Data()[i] = *src; }
+			for (; i < count; ++i, ++src, ++size_) { _Construct_at(_Data() + i, *src); }
+			_Destroy_range(_Data() + count, _Data() + size_);
+			if (count < size_) { size_ = count; }
+		}
+	};
+
+	// 容量固定为N、从不分配内存的 vector，元素直接存放在对象内部且不预先构造
+	// 超出容量时 push_back/emplace_back/insert 抛出 std::bad_alloc，try_emplace_back 返回 nullptr
+	// 迭代器为原始指针，平凡类型的全部操作都可以在常量表达式中使用
+	template<typename Tp, size_t N>
+	class static_vector : private _Static_vector_storage<Tp, N> {
+	private:
+		using _Mybase = _Static_vector_storage<Tp, N>;
+		using _Mybase::_Data;
+		using _Mybase::_Construct_at;
+		using _Mybase::_Destroy_range;
+		using _Mybase::_Append_n;
+
+	public:
+		static_assert(N > 0, "static_vector needs a positive capacity.");
+		static_assert(!mstd::is_const_v<Tp>, "The container element is not allowed to be const type.");
+
+		using value_type = Tp;
+		using pointer = value_type*;
+		using reference = value_type&;
+		using const_pointer = const value_type*;
+		using const_reference = const value_type&;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+
+		using iterator = pointer;
+		using const_iterator = const_pointer;
+		using reverse_iterator = mstd::reverse_iterator<iterator>;
+		using const_reverse_iterator = mstd::reverse_iterator<const_iterator>;
+
+	private:
+		constexpr pointer _Myfirst() noexcept { return _Data(); }
+		constexpr const_pointer _Myfirst() const noexcept { return _Data(); }
+		constexpr pointer _Mylast() noexcept { return _Data() + this->size_; }
+		constexpr const_pointer _Mylast() const noexcept { return _Data() + this->size_; }
+
+		constexpr void check_capacity(size_type n) const {
+			if (n > N - size()) { throw std::bad_alloc(); }
+		}
+
+		constexpr pointer to_mutable(const_iterator pos) noexcept {
+			return _Myfirst() + (pos - _Myfirst());
+		}
+
+		//将[pos, finish)之间的元素向前移动n个位置，销毁末尾多出的n个元素
+		constexpr void move_forward_n(pointer pos, size_type n) {
+			pointer last = _Mylast();
+			for (pointer src = pos; src != last; ++src) {
+				*(src - n) = mstd::move(*src);
+			}
+			_Destroy_range(last - n, last);
+			this->size_ -= n;
+		}
+
+		constexpr bool is_invalid_iterator(const_iterator pos) const noexcept {
+			return pos < _Myfirst() || pos >= _Mylast();
+		}
+
+		constexpr bool is_invalid_insert_iterator(const_iterator pos) const noexcept {
+			return pos < _Myfirst() || pos > _Mylast();
+		}
+
+	public:
+		constexpr static_vector() noexcept = default;
+		constexpr explicit static_vector(size_type size) {
+			resize(size);
+		}
+		constexpr static_vector(size_type size, const value_type& value) {
+			assign(size, value);
+		}
+		template <typename IptIter, std::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
+		constexpr static_vector(IptIter first, IptIter last) {
+			assign(first, last);
+		}
+		constexpr static_vector(std::initializer_list<value_type> ilist) {
+			assign(ilist.begin(), ilist.end());
+		}
+		constexpr static_vector& operator=(std::initializer_list<value_type> ilist) {
+			assign(ilist.begin(), ilist.end());
+			return *this;
+		}
+
+	public:
+		constexpr iterator begin() noexcept { return _Myfirst(); }
+		constexpr iterator end() noexcept { return _Mylast(); }
+		constexpr const_iterator begin() const noexcept { return _Myfirst(); }
+		constexpr const_iterator end() const noexcept { return _Mylast(); }
+		constexpr const_iterator cbegin() const noexcept { return _Myfirst(); }
+		constexpr const_iterator cend() const noexcept { return _Mylast(); }
+		constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		constexpr const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+		constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+		constexpr reference at(size_type index) {
+			if (index >= size()) {
+				throw std::out_of_range
+				{ "static_vector member func at() error: index out of range" };
+			}
+			return _Myfirst()[index];
+		}
+		constexpr const_reference at(size_type index) const {
+			if (index >= size()) {
+				throw std::out_of_range
+				{ "static_vector member func at() error: index out of range" };
+			}
+			return _Myfirst()[index];
+		}
+		constexpr reference operator[](size_type index) noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(index < size(), "static_vector subscript out of range");
+			return _Myfirst()[index];
+		}
+		constexpr const_reference operator[](size_type index) const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(index < size(), "static_vector subscript out of range");
+			return _Myfirst()[index];
+		}
+		constexpr reference front() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "front() called on empty static_vector");
+			return *_Myfirst();
+		}
+		constexpr const_reference front() const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "front() called on empty static_vector");
+			return *_Myfirst();
+		}
+		constexpr reference back() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "back() called on empty static_vector");
+			return *(_Mylast() - 1);
+		}
+		constexpr const_reference back() const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "back() called on empty static_vector");
+			return *(_Mylast() - 1);
+		}
+		constexpr Tp* data() noexcept { return _Myfirst(); }
+		constexpr const Tp* data() const noexcept { return _Myfirst(); }
+
+		constexpr size_type size() const noexcept { return this->size_; }
+		static constexpr size_type capacity() noexcept { return N; }
+		static constexpr size_type max_size() noexcept { return N; }
+		constexpr bool empty() const noexcept { return 0 == this->size_; }
+		constexpr bool full() const noexcept { return N == this->size_; }
+
+		template<typename IptIter, std::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
+		constexpr void assign(IptIter first, IptIter last) {
+			clear();
+			for (; first != last; ++first) {
+				emplace_back(*first);
+			}
+		}
+
+		constexpr void assign(std::initializer_list<value_type> ilist) {
+			assign(ilist.begin(), ilist.end());
+		}
+
+		constexpr void assign(size_type size, const value_type& value) {
+			check_capacity(size > this->size_ ? size - this->size_ : 0);
+			clear();
+			for (; this->size_ != size; ++this->size_) {
+				_Construct_at(_Mylast(), value);
+			}
+		}
+
+		template <typename... Args>
+		constexpr reference emplace_back(Args&&... args) {
+			check_capacity(1);
+			return unchecked_emplace_back(mstd::forward<Args>(args)...);
+		}
+
+		// 容量已满时返回 nullptr，不抛出异常
+		template <typename... Args>
+		constexpr pointer try_emplace_back(Args&&... args) {
+			if (full()) { return nullptr; }
+			return &unchecked_emplace_back(mstd::forward<Args>(args)...);
+		}
+
+		// 调用者保证容量足够
+		template <typename... Args>
+		constexpr reference unchecked_emplace_back(Args&&... args) {
+			pointer p = _Mylast();
+			_Construct_at(p, mstd::forward<Args>(args)...);
+			++this->size_;
+			return *p;
+		}
+
+		constexpr void push_back(const value_type& val) { emplace_back(val); }
+		constexpr void push_back(value_type&& val) { emplace_back(mstd::move(val)); }
+
+		constexpr pointer try_push_back(const value_type& val) { return try_emplace_back(val); }
+		constexpr pointer try_push_back(value_type&& val) { return try_emplace_back(mstd::move(val)); }
+
+		constexpr void pop_back() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "pop_back() called on empty static_vector");
+			--this->size_;
+			_Destroy_range(_Mylast(), _Mylast() + 1);
+		}
+
+		template <typename... Args>
+		constexpr iterator emplace(const_iterator pos, Args&&... args) {
+			_MSTD_HARDENED_CHECK(!is_invalid_insert_iterator(pos),
+				"static_vector member func emplace() error: iterator out of range");
+			check_capacity(1);
+			pointer new_pos = to_mutable(pos);
+			// 先在末尾构造再旋转到位：构造抛出异常时容器不变，参数引用本容器中的元素时也不会被提前移走
+			unchecked_emplace_back(mstd::forward<Args>(args)...);
+			mstd::rotate(new_pos, _Mylast() - 1, _Mylast());
+			return new_pos;
+		}
+
+		constexpr iterator insert(const_iterator pos, const value_type& val) {
+			return emplace(pos, val);
+		}
+
+		constexpr iterator insert(const_iterator pos, value_type&& val) {
+			return emplace(pos, mstd::move(val));
+		}
+
+		constexpr iterator insert(const_iterator pos, size_type num, const value_type& value) {
+			_MSTD_HARDENED_CHECK(!is_invalid_insert_iterator(pos),
+				"static_vector member func insert() error: iterator out of range");
+			check_capacity(num);
+			pointer new_pos = to_mutable(pos);
+			const size_type old_size = size();
+			_Append_n(num, [this, &value](pointer p) { _Construct_at(p, value); });
+			mstd::rotate(new_pos, _Myfirst() + old_size, _Mylast());
+			return new_pos;
+		}
+
+		template<typename IptIter, std::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
+		constexpr iterator insert(const_iterator pos, IptIter first, IptIter last) {
+			_MSTD_HARDENED_CHECK(!is_invalid_insert_iterator(pos),
+				"static_vector member func insert() error: iterator out of range");
+			const auto num = static_cast<size_type>(std::distance(first, last));
+			check_capacity(num);
+			pointer new_pos = to_mutable(pos);
+			const size_type old_size = size();
+			_Append_n(num, [this, &first](pointer p) { _Construct_at(p, *first); ++first; });
+			mstd::rotate(new_pos, _Myfirst() + old_size, _Mylast());
+			return new_pos;
+		}
+
+		constexpr iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
+			return insert(pos, ilist.begin(), ilist.end());
+		}
+
+		constexpr iterator erase(const_iterator pos) {
+			_MSTD_HARDENED_CHECK(!is_invalid_iterator(pos),
+				"static_vector member func erase() error: iterator out of range");
+			pointer new_pos = to_mutable(pos);
+			move_forward_n(new_pos + 1, 1);
+			return new_pos;
+		}
+
+		constexpr iterator erase(const_iterator first, const_iterator last) {
+			_MSTD_HARDENED_CHECK(!(is_invalid_insert_iterator(first) || is_invalid_insert_iterator(last) || last < first),
+				"static_vector member func erase() error: iterator out of range");
+			pointer new_first = to_mutable(first);
+			if (first != last) {
+				move_forward_n(to_mutable(last), static_cast<size_type>(last - first));
+			}
+			return new_first;
+		}
+
+		constexpr void resize(size_type new_sz) {
+			if (new_sz > size()) {
+				check_capacity(new_sz - size());
+				for (; this->size_ != new_sz; ++this->size_) {
+					_Construct_at(_Mylast());
+				}
+			}
+			else {
+				_Destroy_range(_Myfirst() + new_sz, _Mylast());
+				this->size_ = new_sz;
+			}
+		}
+
+		constexpr void resize(size_type new_sz, const value_type& value) {
+			if (new_sz > size()) {
+				check_capacity(new_sz - size());
+				for (; this->size_ != new_sz; ++this->size_) {
+					_Construct_at(_Mylast(), value);
+				}
+			}
+			else {
+				_Destroy_range(_Myfirst() + new_sz, _Mylast());
+				this->size_ = new_sz;
+			}
+		}
+
+		// 容量固定，只检查n是否超过容量
+		constexpr void reserve(size_type n) const {
+			if (n > N) { throw std::bad_alloc(); }
+		}
+
+		constexpr void shrink_to_fit() noexcept {}
+
+		constexpr void clear() noexcept {
+			_Destroy_range(_Myfirst(), _Mylast());
+			this->size_ = 0;
+		}
+
+		constexpr void swap(static_vector& right) {
+			static_vector temp(mstd::move(right));
+			right = mstd::move(*this);
+			*this = mstd::move(temp);
+		}
+	};
+
+	template<typename Tp, size_t N>
+	constexpr void swap(static_vector<Tp, N>& left, static_vector<Tp, N>& right) {
+		left.swap(right);
+	}
+
+	template<typename Tp, size_t N>
+	constexpr bool operator==(const static_vector<Tp, N>& left, const static_vector<Tp, N>& right) {
+		if (left.size() != right.size()) { return false; }
+		for (size_t i = 0; i != left.size(); ++i) {
+			if (!(left[i] == right[i])) { return false; }
+		}
+		return true;
+	}
+
+	template<typename Tp, size_t N>
+	constexpr bool operator!=(const static_vector<Tp, N>& left, const static_vector<Tp, N>& right) {
+		return !(left == right);
+	}
+
+	template<typename Tp, size_t N>
+	constexpr bool operator<(const static_vector<Tp, N>& left, const static_vector<Tp, N>& right) {
+		for (size_t i = 0; i != left.size() && i != right.size(); ++i) {
+			if (left[i] < right[i]) { return true; }
+			if (right[i] < left[i]) { return false; }
+		}
+		return left.size() < right.size();
+	}
+
+	template<typename Tp, size_t N>
+	constexpr bool operator>(const static_vector<Tp, N>& left, const static_vector<Tp, N>& right) {
+		return right < left;
+	}
+
+	template<typename Tp, size_t N>
+	constexpr bool operator<=(const static_vector<Tp, N>& left, const static_vector<Tp, N>& right) {
+		return !(right < left);
+	}
+
+	template<typename Tp, size_t N>
+	constexpr bool operator>=(const static_vector<Tp, N>& left, const static_vector<Tp, N>& right) {
+		return !(left < right);
+	}
+}
@@ -1,12 +1,12 @@
-#pragma once  // ļжļǷͬ
+#pragma once  // 编译器根据文件属性判断两个文件是否相同
 #ifndef _M_TYPE_TRAITS_H_
 #define _M_TYPE_TRAITS_H_
 
 #include <cstddef> 
 
 /*
-* ڲintrinsic
-* C++11УҪʵжϣ
+* 编译器内部的intrinsic，
+* C++11中，需要编译器实现判断：
 * is_class;
 * is_union;
 * is_enum;
@@ -30,126 +30,127 @@
 * alignment_of
 */
 
-///  ж type predicate    
+///  判断类型类别 type predicate    
 //
-// is_void : Ƿvoidͣ
-// is_integral :  bool/char/char16_t/char32_t/wchar_t/[unsigned] short/int/long/long long
-// is_floating_point : floating pointfloat/double/long double
-// is_arithmetic : ͣarithmetic/
-// is_signed/is_unsigned : ǷзŻ޷ͣ
-// is_const : Ƿ const
-// is_volatile : Ƿ volatile
-// is_array : 飨std::array
-// is_enum : ö٣enumeration
-// is_union : 壨union
-// is_class : class/struct ͣunion
-// is_function : Ƿ ͣ
+// is_void : 是否是void类型；
+// is_integral : 整数 bool/char/char16_t/char32_t/wchar_t/[unsigned] short/int/long/long long；
+// is_floating_point : 浮点数（floating point）：float/double/long double；
+// is_arithmetic : 算术类型（arithmetic）：整数/浮点数；
+// is_signed/is_unsigned : 是否是有符号或无符号类型；
+// is_const : 是否是 const；
+// is_volatile : 是否是 volatile；
+// is_array : 内置数组（非std::array）；
+// is_enum : 枚举（enumeration）；
+// is_union : 联合体（union）；
+// is_class : class/struct 类型（非union）
+// is_function : 是否是 函数类型；
 //
-// is_reference : ãֵֵã
-// is_lvalue_reference : ֵã
-// is_rvalue_reference : ֵã
-// is_pointer : pointer ͣ!is_member_pointer
-// is_member_pointer : ָ nostatic Աָ루is_member_function_pointer+is_member_object_pointer
-// is_member_object_pointer : ָ nostatic ݳԱָ룻
-// is_member_function_pointer : ָ nostatic Աָ(ͨԱת͵òԱ)
+// is_reference : 引用：左值或右值引用；
+// is_lvalue_reference : 左值引用；
+// is_rvalue_reference : 右值引用；
+// is_pointer : pointer 类型（!is_member_pointer）；
+// is_member_pointer : 指向 nostatic 成员的指针（is_member_function_pointer+is_member_object_pointer）；
+// is_member_object_pointer : 指向 nostatic 数据成员的指针；
+// is_member_function_pointer : 指向 nostatic 成员函数的指针(包括普通成员函数、调用类型转换和调用操作符成员函数)；
 //
-// is_fundamental : ͣ/void/nullptr_t
-// is_scalar : /ö/pointer/member pointer/nullptr_t
-// is_object : ͣ void/function/reference!is_fundamental
-// is_compound : /enumeration/union/class/function/reference/pointer
-// is_trivial : scalar/trivial class/ scalar  trivial class ɵ飻
-// is_trivially_copyable : scalar/trivial copyable class/scalartrivial copyable classɵ飬safe memcpy()ȣ
-// is_standard_layout : scalar/standard layout class/ scalar  standard layout class ɵ飻
-// is_pod : plain old data typeʹ memcpy() memmove()
-// is_literal_type : scalar/reference/class/ scalarreferenceclass ɵ飻
-
-
-///  ж class ʵϸ
+// is_fundamental : 基础类型：算术类型/void/nullptr_t；
+// is_scalar : 标量：算术类型/枚举/pointer/member pointer/nullptr_t；
+// is_object : 对象类型（不包括 void/function/reference）（!is_fundamental）；
+// is_compound : 数组/enumeration/union/class/function/reference/pointer；
+// is_trivial : scalar/trivial class/由 scalar 和 trivial class 构成的数组；
+// is_trivially_copyable : scalar/trivial copyable class/由scalar或trivial copyable class构成的数组，safe memcpy()等；
+// is_standard_layout : scalar/standard layout class/由 scalar 或 standard layout class 构成的数组；
+// is_pod : plain old data type，可以使用 memcpy() memmove()；
+// is_literal_type : scalar/reference/class/由 scalar、reference和class 构成的数组；
+
+
+///  判断 class 类型实现细节
 //
-// is_empty : class κγԱ/virtual Ա/virtual base class
-// is_polymorphic : class һderivedvirtual Ա
-// is_abstract : abstract classһ pure virtual 
-// has_virtual_destructor : class  
+// is_empty : class 不带任何成员/virtual 成员函数/virtual base class；
+// is_polymorphic : class 带有一个（derived）virtual 成员函数；
+// is_abstract : abstract class（至少有一个 pure virtual 函数）；
+// has_virtual_destructor : class 带有 虚析构函数；
 //
-// is_default_constructible : Ƿܹ ĬϹ죻
-// is_copy_constructible : ǹܹ 죻
-// is_move_constructible : Ƿܹ ƶ죻
-// is_copy_assignable : Ƿܹ ֵ
-// is_move_assignable : Ƿܹ ƶֵ
-// is_destructiable : Ƿܹ  deleted/protected/private
+// is_default_constructible : 是否能够完成 默认构造；
+// is_copy_constructible : 是够能够完成 拷贝构造；
+// is_move_constructible : 是否能够完成 移动构造；
+// is_copy_assignable : 是否能够完成 拷贝赋值；
+// is_move_assignable : 是否能够完成 移动赋值；
+// is_destructiable : 是否能够完成 析构（析构函数不能是 deleted/protected/private）；
 //
-// is_trivially_default_constructible : Ƿܹ trivial ĬϹ죻
-// is_trivially_copy_constructible : ǹܹ trivial 죻
-// is_trivially_move_constructible : Ƿܹ trivial ƶ죻
-// is_trivially_copy_assignable : Ƿܹ trivial ֵ
-// is_trivially_move_assignable : Ƿܹ trivial ƶֵ
-// is_trivially_destructiable : Ƿܹ trivial ;
+// is_trivially_default_constructible : 是否能够完成 trivial 默认构造；
+// is_trivially_copy_constructible : 是够能够完成 trivial 拷贝构造；
+// is_trivially_move_constructible : 是否能够完成 trivial 移动构造；
+// is_trivially_copy_assignable : 是否能够完成 trivial 拷贝赋值；
+// is_trivially_move_assignable : 是否能够完成 trivial 移动赋值；
+// is_trivially_destructiable : 是否能够完成 trivial 析构;
+// is_trivially_relocatable : 移动到新地址再析构原对象 可以用一次 memcpy() 完成，可以特化；
 //
-// is_nothrow_default_constructible : Ƿܹ nothrow ĬϹ죻
-// is_nothrow_copy_constructible : ǹܹ nothrow 죻
-// is_nothrow_move_constructible : Ƿܹ nothrow ƶ죻
-// is_nothrow_copy_assignable : Ƿܹ nothrow ֵ
-// is_nothrow_move_assignable : Ƿܹ nothrow ƶֵ
-// is_nothrow_destructiable : Ƿܹ nothrow ;
+// is_nothrow_default_constructible : 是否能够完成 nothrow 默认构造；
+// is_nothrow_copy_constructible : 是够能够完成 nothrow 拷贝构造；
+// is_nothrow_move_constructible : 是否能够完成 nothrow 移动构造；
+// is_nothrow_copy_assignable : 是否能够完成 nothrow 拷贝赋值；
+// is_nothrow_move_assignable : 是否能够完成 nothrow 移动赋值；
+// is_nothrow_destructiable : 是否能够完成 nothrow 析构;
 
 
-///  ֮ϵ
+///  检验类型之间关系
 //
-// is_same <T1,T2> : T1T2 Ƿͬ const/volatile
-// is_base_of <T1,T2> : T1 Ƿ T2  base class
-// is_convertible <T1,T2> : T1 Ƿת T2
+// is_same <T1,T2> : T1、T2类型 是否相同（包括 const/volatile）；
+// is_base_of <T1,T2> : T1 是否是 T2 的 base class；
+// is_convertible <T1,T2> : T1 是否可转换成 T2；
 //
-// is_constructible <T,Args...> : T Ƿ Args ʼ
-// is_trivially_constructible <T,Args...> : T Ƿ Args trivial ʼ
-// is_nothrow_constructible <T,Args...> : T Ƿ Args nothrow ʼ
+// is_constructible <T,Args...> : T 是否可由 Args 初始化；
+// is_trivially_constructible <T,Args...> : T 是否可由 Args trivial 初始化；
+// is_nothrow_constructible <T,Args...> : T 是否可由 Args nothrow 初始化；
 //
-// is_assignale <T1,T2> : T2 Ƿ ֵ T1
-// is_trivially_assignable <T1,T2> : T2 Ƿ trivial ֵ T1
-// is_nothrow_assignable <T1,T2> : T2 Ƿ nothrow ֵ T1
+// is_assignale <T1,T2> : T2 是否可 赋值给 T1；
+// is_trivially_assignable <T1,T2> : T2 是否可 trivial 赋值给 T1；
+// is_nothrow_assignable <T1,T2> : T2 是否可 nothrow 赋值给 T1；
 //
-// uses_allocator <T,Alloc> : Alloc ǷתΪ T::Allocator
+// uses_allocator <T,Alloc> : Alloc 是否可转换为 T::Allocator；
 
 
-///   Type Trait
+///  其他 Type Trait
 //
-// rank <T> : array ͵άȣ0
-// extent <T,I=0> : άI0ĳ߶ȣextent
-// remove_extent <T> :  array ԪͣTarrayT
-// remove_all_extents <T> : öά array ԪͣTǶάarrayT
+// rank <T> : array 类型的维度（或是0）
+// extent <T,I=0> : 维度I（或0）的尺度（extent）；
+// remove_extent <T> : 获得 array 的元素类型（若T不是array则获得类型T）；
+// remove_all_extents <T> : 获得多维 array 的元素类型（若T不是多维array则获得类型T）；
 //
-// underlying_type <T> : ö͵ĵͲͣ
-// decay <T> :  T תΪ ʵֵ͡"by-value" typeȥref cvη򽫺תΪָͣ
-// enable_if <B,T=void> : ֻе bool B Ϊ true ʱ type T
-// conditional <B,T,F> :  bool B Ϊ true  type T type F
+// underlying_type <T> : 枚举类型的低层类型；
+// decay <T> : 将 T 转化为 “实值类型”（"by-value" type），去掉ref cv修饰符，或将函数或内置数组转换为指针类型；
+// enable_if <B,T=void> : 只有当 bool B 为 true 时会产出 type T；
+// conditional <B,T,F> : 当 bool B 为 true 会产出 type T，否则产出 type F；
 // 
-// common_type <T,...> : б͵Ĺͨͣйͨͣ
-// result_of <F,Arg> :  Arg Ϊʵε F ýͣ
+// common_type <T,...> : 所有被传入类型的共通类型（必须有共通类型）；
+// result_of <F,Arg> : 将 Arg 作为实参调用 F 后，其所得结果的类型；
 //
-// aligned_of <T> : ȼ alignof(T)
-// aligned_sotrage <Len> : Len byte Ĭ϶ɵͣ
-// aligned_storage <Len,Align> : Len byte  size_t Align Լж룬ɵͣ
-// aligned_union <Len,Types...> : Len byte  a union of Types... ж룬ɵͣ
+// aligned_of <T> : 等价于 alignof(T)；
+// aligned_sotrage <Len> : Len byte 加上默认对齐规则所可容纳的类型；
+// aligned_storage <Len,Align> : Len byte 且以 size_t Align 的约数进行对齐，所可容纳的类型；
+// aligned_union <Len,Types...> : Len byte 且以 a union of Types... 进行对齐，所可容纳的类型；
 
 
-///  ޸
+///  进行类型修改
 //
-// remove_const :  const ͣ
-// remove_volatile :  volatile ͣ
-// remove_cv :  const  volatile ͣ
+// remove_const : 不带 const 的类型；
+// remove_volatile : 不带 volatile 的类型；
+// remove_cv : 不带 const 和 volatile 的类型；
 //
-// add_const :  const ͣ
-// add_volatile :  volatile ͣ
-// add_cv :  const  volatile ͣ
+// add_const : 带 const 的类型；
+// add_volatile : 带 volatile 的类型；
+// add_cv : 带 const 和 volatile 的类型；
 //
-// make_signed : Ӧ signed noreference ͣ
-// make_unsigned : Ӧ unsigned noreference ͣ
+// make_signed : 对应 signed noreference 的类型；
+// make_unsigned : 对应 unsigned noreference 的类型；
 //
-// remove_reference : Ӧ noreference ͣ
-// add_lvalue_reference : Ӧ ֵãֵֵ
-// add_rvalue_reference : Ӧ ֵãֵ䣩
+// remove_reference : 对应 noreference 类型；
+// add_lvalue_reference : 对应 左值引用（右值变左值）；
+// add_rvalue_reference : 对应 右值引用（左值不变）；
 //
-// remove_pointer : õpointer ָͣǷpointer,ԭͣ
-// add_pointer : õһ pointer ָͣӦ noreference ͣ
+// remove_pointer : 得到pointer 所指向的类型（若是非pointer,则是原类型）；
+// add_pointer : 得到一个 pointer 类型，指向对应 noreference 类型；
 
 
 namespace mstd {
@@ -550,7 +551,7 @@ namespace mstd {
 	template<class Tp>
 	struct is_null_pointer : bool_constant<is_null_pointer_v<Tp>> {};
 
-	// ʵ
+	// 依赖编译器实现
 	template<class Tp>
 	using is_union = std::is_union<Tp>;		// using std::is_union<>;
 
@@ -752,6 +753,15 @@ namespace mstd {
 	template<class Tp>
 	using is_nothrow_destructible = std::is_nothrow_destructible<Tp>;
 
+	// 默认由 trivial 移动构造和 trivial 析构推出，不依赖自身地址的类型
+	// (unique_ptr 一类的句柄、vector 等)可以特化为 true_type
+	template<class Tp>
+	struct is_trivially_relocatable : bool_constant<is_trivially_move_constructible<Tp>::value
+		&& is_trivially_destructible<Tp>::value> {};
+
+	template<class Tp>
+	constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<remove_cv_t<Tp>>::value;
+
 	template<class Tp, bool = mstd::is_integral_v<Tp>>
 	struct _is_signed {
 		using _Rp = remove_cv_t<Tp>;
@@ -1036,19 +1046,19 @@ namespace mstd {
 	template<class Tp1, class Tp2, class... Rest>
 	struct common_type<Tp1, Tp2, Rest...> : _Common_type2<void, Tp1, Tp2, Rest...> {};
 
-	// ʵ reference_wrapper<>;
+	// 实现 reference_wrapper<>;
 	template<class Tp>
 	class reference_wrapper;
 
 	enum class _Invoker_strategy {
-		_Functor,		// вηºвκָĵã
-		_Pmf_object,	// ʵóԱָ룻
-		_Pmf_refwrap,	// ðװóԱָ룻
-		_Pmf_pointer,	// ָóԱָ룻
+		_Functor,		// 有参仿函数或有参函数指针的调用；
+		_Pmf_object,	// 对象实例调用成员函数指针；
+		_Pmf_refwrap,	// 引用包装器调用成员函数指针；
+		_Pmf_pointer,	// 对象指针调用成员函数指针；
 
-		_Pmd_object,	// ʵóԱָ룻
-		_Pmd_refwrap,	// ðװóԱָ룻
-		_Pmd_pointer	// ָóԱָ룻
+		_Pmd_object,	// 对象实例调用成员数据指针；
+		_Pmd_refwrap,	// 引用包装器调用成员数据指针；
+		_Pmd_pointer	// 对象指针调用成员数据指针；
 	};
 
 	struct _Invoker_Functor {
@@ -1147,7 +1157,7 @@ namespace mstd {
 	template<class Callable, class Tp, class _Removed_cvref>
 	struct _Invoker<Callable, Tp, _Removed_cvref, false, false> : _Invoker_Functor {};
 
-	template<class Callable>	// ޲ηº޲κָ
+	template<class Callable>	// 无参仿函数和无参函数指针调用
 	inline auto invoke(Callable&& obj) noexcept(noexcept(static_cast<Callable&&>(obj)()))
 		-> decltype(static_cast<Callable&&>(obj)()) {
 		return static_cast<Callable&&>(obj)();
@@ -1181,7 +1191,7 @@ namespace mstd {
 	}
 
 	template<class Tp>
-	Tp _Fake_copy_init(Tp) noexcept; // not definedòʱĿΪ
+	Tp _Fake_copy_init(Tp) noexcept; // not defined，利用参数传递时的拷贝行为
 
 	// _Fake_copy_init<T>(E):
 	// (1) has type T [decay_t<decltype((E))> if T is deduced],
@@ -1189,7 +1199,7 @@ namespace mstd {
 	// (3) is non-throwing if and only if both conversion from decltype((E)) to T and destruction of T are non-throwing.
 
 	template<class Tp>
-	Tp _Returns_exactly() noexcept; // not definedTp͵ֵͬdeclval()ĶڷͷTp&&
+	Tp _Returns_exactly() noexcept; // not defined，返回Tp类型的值，不同于declval()的对于非引用类型返回Tp&&
 
 	template<class From, class To, bool = mstd::is_convertible_v<From, To>, bool = is_void_v<To>>
 	constexpr bool _is_nothrow_convertible_v = noexcept(_Fake_copy_init<To>(declval<From>()));
@@ -1241,7 +1251,7 @@ namespace mstd {
 	template<class Tp>
 	using _Identity_t = typename _Identity<Tp>::type;
 
-	// not define, úжǷתΪTp&reference_wrapper˵Tp&ʽת
+	// not define, 利用函数传参用于判断是否可以转换为Tp&（reference_wrapper定义了到Tp&的隐式转换）
 	template<class Tp>
 	void _Refwrap_ctor_fun(_Identity_t<Tp&>) noexcept;
 
@@ -1269,7 +1279,7 @@ namespace mstd {
 		template<class Utp, enable_if_t<conjunction_v<negation<is_same<_Remove_cvref_t<Tp>, reference_wrapper>>,
 			_Refwrap_has_ctor_from<Tp, Utp>>, int> = 0 >
 		reference_wrapper(Utp&& val) noexcept(noexcept(_Refwrap_ctor_fun<Tp>(declval<Utp>()))) {
-			Tp& _ref = static_cast<Utp&&>(val);  // ΪֵΪڴ
+			Tp& _ref = static_cast<Utp&&>(val);  // 若为右值则会为其分配内存
 			ptr_ = std::addressof(_ref);
 		}
 
@@ -1281,7 +1291,7 @@ namespace mstd {
 			return *ptr_;
 		}
 
-		// TpΪɵ
+		// Tp为可调用类型
 		template<class... Types>
 		auto operator()(Types&&...args) const
 			noexcept(noexcept(mstd::invoke(*ptr_, static_cast<Types&&>(args)...)))
@@ -1296,7 +1306,7 @@ namespace mstd {
 	}
 
 	template<class Tp>
-	void ref(const Tp&&) = delete; // ֵɱװװ
+	void ref(const Tp&&) = delete; // 常量右值不可被包装器包装
 
 	template<class Tp>
 	inline reference_wrapper<Tp> ref(reference_wrapper<Tp>& val) noexcept {
@@ -1318,8 +1328,8 @@ namespace mstd {
 
 namespace gnu_type_traits {
 
-	///  true_type / false_type
-	/// integral_constant  true_type/false_type Ļ࣬rank/extent Ļ
+	/// 定义 true_type / false_type
+	/// integral_constant 是 true_type/false_type 的基类，rank/extent 的基类
 	template<typename _IntglConst, _IntglConst __value>
 	struct integral_constant {
 		static constexpr _IntglConst value = __value;
@@ -1328,18 +1338,18 @@ namespace gnu_type_traits {
 		constexpr operator value_type() const { return value; }
 	};
 
-	// ľ̬ⲿʼ
+	// 类的静态变量外部初始化
 	template<typename _IntglConst, _IntglConst __value>
 	constexpr _IntglConst integral_constant<_IntglConst, __value>::value;
 
 	typedef integral_constant<bool, true> true_type;
 	typedef integral_constant<bool, false> false_type;
 
-	///  __and_ / __or_ / __not_ / __failure_type / __success_type
-	// __and_ / __or_ / __not_ ģģǻ̳ true_type / false_type 
+	/// 辅助工具 __and_ / __or_ / __not_ / __failure_type / __success_type
+	// __and_ / __or_ / __not_ 模板参数及模板类自身是或继承自 true_type / false_type 类型
 
 	template<bool, typename, typename>
-	struct conditional; // ǰ for __and_ / __or_
+	struct conditional; // 前置声明 for __and_ / __or_
 
 	/// __and_
 	template<typename...>
@@ -1372,13 +1382,13 @@ namespace gnu_type_traits {
 	struct __not_ : public integral_constant<bool, !_T::value> {};
 
 	template<typename>
-	struct remove_cv; // ǰ for is_void/is_integral/is_pointer.../, ȥ const/volatile
+	struct remove_cv; // 前置声明 for is_void/is_integral/is_pointer.../, 先去掉 const/volatile
 
 	template<typename>
 	struct __is_void_helper : false_type {};
 	template<>
 	struct __is_void_helper<void> : true_type {};
-	/// is_void : Ƿ voidͣ
+	/// is_void : 是否是 void类型；
 	template<typename _T>
 	struct is_void
 		: public __is_void_helper<typename remove_cv<_T>::type>::type {};
@@ -1415,8 +1425,8 @@ namespace gnu_type_traits {
 	struct __is_integral_helper<long long> : public true_type {};
 	template<>
 	struct __is_integral_helper<unsigned long long> : public true_type {};
-	/// is_integral : Ƿ 
-	/// bool/char/char16_t/char32_t/wchar_t/[unsigned] short/int/long/long long
+	/// is_integral : 是否是 整数
+	/// bool/char/char16_t/char32_t/wchar_t/[unsigned] short/int/long/long long；
 	template<typename _T>
 	struct is_integral
 		: public __is_integral_helper<typename remove_cv<_T>::type> {};
@@ -1429,12 +1439,12 @@ namespace gnu_type_traits {
 	struct __is_floating_point_helper<double> : public true_type {};
 	template<>
 	struct __is_floating_point_helper<long double> : public true_type {};
-	/// is_floating_point : Ƿ float/double/long double
+	/// is_floating_point : 是否是 浮点数：float/double/long double；
 	template<typename _T>
 	struct is_floating_point
 		: public __is_floating_point_helper<typename remove_cv<_T>::type> {};
 
-	/// is_arithmetic : Ƿ ͣ/
+	/// is_arithmetic : 是否是 算术类型：整数/浮点数；
 	template<typename _T>
 	struct is_arithmetic
 		: public __or_<is_integral<_T>, is_floating_point<_T>>::type {};
@@ -1444,28 +1454,28 @@ namespace gnu_type_traits {
 	template<typename _T>
 	struct __is_signed_helper<_T, true>
 		: public integral_constant<bool, _T(-1) < _T(0) > {};
-	/// is_signed : Ƿ зͣ
+	/// is_signed : 是否是 有符号算术类型；
 	template<typename _T>
 	struct is_signed : public __is_signed_helper<_T>::type {};
 
-	/// is_unsigned : Ƿ ޷ͣ
+	/// is_unsigned : 是否是 无符号算术类型；
 	template<typename _T>
 	struct is_unsigned
 		: public __and_<is_arithmetic<_T>, __not_<is_signed<_T>>>::type {};
 
-	/// is_const : Ƿ const
+	/// is_const : 是否是 const；
 	template<typename _T>
 	struct is_const : public false_type {};
 	template<typename _T>
 	struct is_const<const _T> : public true_type {};
 
-	/// is_volatile : Ƿ volatile
+	/// is_volatile : 是否是 volatile；
 	template<typename _T>
 	struct is_volatile : public false_type {};
 	template<typename _T>
 	struct is_volatile<volatile _T> : public true_type {};
 
-	/// is_array : Ƿ 飨std::array
+	/// is_array : 是否是 内置数组（非std::array）；
 	template<typename>
 	struct is_array : false_type {};
 	template<typename _T>
@@ -1473,29 +1483,29 @@ namespace gnu_type_traits {
 	template<typename _T, std::size_t _Size>
 	struct is_array<_T[_Size]> : public true_type {};
 
-	/// is_enum : Ƿ ö٣enumeration
+	/// is_enum : 是否是 枚举（enumeration）；
 	template<typename Tp>
 	struct is_enum : public integral_constant<bool, __is_enum(Tp)> {};
 
-	/// is_union : Ƿ 壨union
+	/// is_union : 是否是 联合体（union）；
 	template<typename Tp>
 	struct is_union : public integral_constant<bool, __is_union(Tp)> {};
 
-	/// is_class : Ƿ class/struct ͣunion
+	/// is_class : 是否是 class/struct 类型（非union）
 	template<typename Tp>
 	struct is_class : public integral_constant<bool, __is_class(Tp)> {};
 
-	/// is_function : Ƿ ͣ
+	/// is_function : 是否是 函数类型；
 	template<typename>
 	struct is_function : false_type {};
-	// һĺƫػ
-	template<typename _Ret, typename... Args> // ɱ
+	// 一般的函数类型偏特化
+	template<typename _Ret, typename... Args> // 不可变参数函数类型
 	struct is_function<_Ret(Args...)> : true_type {};
-	// Partial specialization of function type : ReturnType(Type1,Type2,Args...)  ->  printf 
-	template<typename _Ret, typename... Args>  // ɱ
+	// Partial specialization of function type : ReturnType(Type1,Type2,Args...)  -> 类似 printf 函数
+	template<typename _Ret, typename... Args>  // 可变参数函数类型
 	struct is_function<_Ret(Args......)> : true_type {};
-	// رĺƫػ
-	// +volatileԱƫػ
+	// 特别的函数类型偏特化
+	// 常量+volatile成员函数类型偏特化
 	template<typename _Ret, typename... Args>
 	struct is_function<_Ret(Args...) const> : true_type {};
 	template<typename _Ret, typename... Args>
@@ -1508,7 +1518,7 @@ namespace gnu_type_traits {
 	struct is_function<_Ret(Args......) volatile> : true_type {};
 	template<typename _Ret, typename... Args>
 	struct is_function<_Ret(Args......) const volatile> : true_type {};
-	// óԱƫػ
+	// 引用成员函数类型偏特化
 	template<typename _Ret, typename... Args>
 	struct is_function<_Ret(Args...)&> : true_type {};
 	template<typename _Ret, typename... Args>
@@ -1541,21 +1551,21 @@ namespace gnu_type_traits {
 	struct is_function<_Ret(Args......) volatile&&> : true_type {};
 	template<typename _Ret, typename... Args>
 	struct is_function<_Ret(Args......) const volatile&&> : true_type {};
-	// C++17  noexcept  is_function ƫػ汾
+	// C++17 出现 noexcept 的 is_function 的偏特化版本
 
-	/// is_lvalue_reference : Ƿ ֵã
+	/// is_lvalue_reference : 是否是 左值引用；
 	template<typename _T>
 	struct is_lvalue_reference : public false_type {};
 	template<typename _T>
 	struct is_lvalue_reference<_T&> : public true_type {};
 
-	/// is_rvalue_reference : Ƿ ֵã
+	/// is_rvalue_reference : 是否是 右值引用；
 	template<typename _T>
 	struct is_rvalue_reference : public false_type {};
 	template<typename _T>
 	struct is_rvalue_reference<_T&&> : public true_type {};
 
-	/// is_reference : Ƿ ãֵֵã
+	/// is_reference : 是否是 引用：左值或右值引用；
 	template<typename _T>
 	struct is_reference
 		: public __or_<is_lvalue_reference<_T>, is_rvalue_reference<_T>>::type {};
@@ -1564,27 +1574,27 @@ namespace gnu_type_traits {
 	struct __is_pointer_helper : false_type {};
 	template<typename _T>
 	struct __is_pointer_helper<_T*> : true_type {};
-	/// is_pointer : Ƿ pointer 
-	/// function pointer  pointer to nostatic member
+	/// is_pointer : 是否是 pointer 类型
+	///（包括 function pointer 但不包括 pointer to nostatic member）；
 	template<typename _T>
 	struct is_pointer
-		: __is_pointer_helper<typename remove_cv<_T>::type>::type {}; // Ƴָ뱾const/volatile
+		: __is_pointer_helper<typename remove_cv<_T>::type>::type {}; // 先移除指针本身的const/volatile属性
 
 	template<typename>
 	struct __is_member_pointer_helper : false_type {};
 	template<typename _T, typename _C>
 	struct __is_member_pointer_helper<_T _C::*> : true_type {};
-	/// is_member_pointer : Ƿ ָ nostatic Աָ룻
+	/// is_member_pointer : 是否是 指向 nostatic 成员的指针；
 	template<typename _T>
 	struct is_member_pointer
-		: __is_member_pointer_helper<typename remove_cv<_T>::type>::type {}; // Ƴָ뱾const/volatile
+		: __is_member_pointer_helper<typename remove_cv<_T>::type>::type {}; // 先移除指针本身的const/volatile属性
 
 	template<typename>
 	struct __is_member_object_pointer_helper : public false_type {};
 	template<typename Tp, typename _Cp>
 	struct __is_member_object_pointer_helper<Tp _Cp::*>
-		: public integral_constant<bool, !is_function<Tp>::value> {};  // is_function<_Tp> жϳԱָָͣ_Tp Ƿ 
-	/// is_member_object_pointer : Ƿ ָ nostatic ݳԱָ룻
+		: public integral_constant<bool, !is_function<Tp>::value> {};  // is_function<_Tp> 判断成员指针所指向的类型，_Tp 是否是 函数类型
+	/// is_member_object_pointer : 是否是 指向 nostatic 数据成员的指针；
 	template<typename Tp>
 	struct is_member_object_pointer
 		: public __is_member_object_pointer_helper
@@ -1595,7 +1605,7 @@ namespace gnu_type_traits {
 	template<typename Tp, typename _Cp>
 	struct __is_member_function_pointer_helper<Tp _Cp::*>
 		: public integral_constant<bool, is_function<Tp>::value> {};
-	/// is_member_function_pointer : Ƿ ָ nostatic Աָ룻
+	/// is_member_function_pointer : 是否是 指向 nostatic 成员函数的指针；
 	template<typename Tp>
 	struct is_member_function_pointer
 		: public __is_member_function_pointer_helper
@@ -1605,35 +1615,35 @@ namespace gnu_type_traits {
 	struct __is_null_pointer_helper : public false_type {};
 	template<>
 	struct __is_null_pointer_helper<std::nullptr_t> : public true_type {};
-	/// is_null_pointer : Ƿ ָ룻
+	/// is_null_pointer : 是否是 空指针；
 	template<typename _T>
 	struct is_null_pointer
 		: __is_null_pointer_helper<typename remove_cv<_T>::type>::type {};
 
-	/// is_null_pointer_t : Ƿ nullptr_t
+	/// is_null_pointer_t : 是否是 nullptr_t；
 	template<typename _T>
 	struct is_null_pointer_t
 		: public is_null_pointer<_T>::type {};
 
-	/// is_fundamental : Ƿ ͣvoid//nullptr_t
+	/// is_fundamental : 是否是 基础类型：void/算术类型/nullptr_t；
 	template<typename _T>
 	struct is_fundamental
 		: public __or_< is_void<_T>, is_arithmetic<_T>,
 		is_null_pointer<_T>>::type{};
 
-	/// is_scalar : Ƿ /ö/pointer/member pointer/nullptr_t
+	/// is_scalar : 是否是 标量：算术类型/枚举/pointer/member pointer/nullptr_t；
 	template<typename _T>
 	struct is_scalar
 		: public __or_<is_arithmetic<_T>, is_enum<_T>, is_pointer<_T>,
 		is_member_pointer<_T>, is_null_pointer<_T>>::type{};
 
-	/// is_object : Ƿ κͣ void/function/reference
+	/// is_object : 是否是 任何类型（不包括 void/function/reference）；
 	template<typename _T>
 	struct is_object
 		: public __not_<__or_<is_void<_T>, is_function<_T>, is_reference<_T>>>::type {};
 
-	/// is_compound : Ƿ ͣǻͣ
-	/// /enumeration/union/class/function/reference/pointer
+	/// is_compound : 是否是 复杂类型（非基础类型）
+	/// 包括：数组/enumeration/union/class/function/reference/pointer
 	template<typename _T>
 	struct is_compound
 		: public integral_constant<bool, !is_fundamental<_T>::value> {};
@@ -1641,48 +1651,48 @@ namespace gnu_type_traits {
 	//struct is_compound : public __or_<is_array<_T>, is_enum<_T>, is_union<_T>,
 	//	is_class<_T>, is_function<_T>, is_reference<_T>, is_pointer<_T>>::type{};
 
-	/// is_trivial : scalar/trivial class/ scalar  trivial class ɵ
+	/// is_trivial : scalar/trivial class/由 scalar 和 trivial class 构成的数组
 	template<typename _T>
 	struct is_trivial
 		: public integral_constant<bool, __is_trivial(_T)> {};
 
 	/// is_trivially_copyable
-	/// scalar/trivial copyable class/ scalar  trivial copyable class ɵ
+	/// 包括：scalar/trivial copyable class/由 scalar 和 trivial copyable class 构成的数组
 	template<typename _T>
 	struct is_trivially_copyable
 		: public integral_constant<bool, __is_trivially_copyable(_T)> {};
 
 	/// is_standard_layout
-	/// scalar/standard layout class/ scalar  standard layout class ɵ
+	/// 包括：scalar/standard layout class/由 scalar 和 standard layout class 构成的数组
 	template<typename _T>
 	struct is_standard_layout
 		: public integral_constant<bool, __is_standard_layout(_T)> {};
 
-	/// is_pod : plain old data typeʹ memcpy/memmove
+	/// is_pod : plain old data type，可以使用 memcpy/memmove
 	template<typename Tp>
 	struct is_pod : public integral_constant<bool, __is_pod(Tp)> {};
 
-	/// is_literal_type : scalar/reference/class/ scalarreferenceclass ɵ飻
+	/// is_literal_type : scalar/reference/class/由 scalar、reference和class 构成的数组；
 	template<typename _T>
 	struct is_literal_type : public integral_constant<bool, __is_literal_type(_T)> {};
 
 
 
-	/// is_empty : class κγԱ/virtual Ա/virtual base class
+	/// is_empty : class 不带任何成员/virtual 成员函数/virtual base class；
 	template<typename _T>
 	struct is_empty : public integral_constant<bool, __is_empty(_T)> {};
 
-	/// is_polymorphic : class һderivedvirtual Ա
+	/// is_polymorphic : class 带有一个（derived）virtual 成员函数；
 	template<typename _T>
 	struct is_polymorphic
 		: public integral_constant<bool, __is_polymorphic(_T)> {};
 
-	/// is_abstract : abstract classһ pure virtual 
+	/// is_abstract : abstract class（至少有一个 pure virtual 函数）；
 	template<typename _T>
 	struct is_abstract
 		: public integral_constant<bool, __is_abstract(_T)> {};
 
-	/// has_virtual_destructor : class  
+	/// has_virtual_destructor : class 带有 虚析构函数；
 	template<typename _T>
 	struct has_virtual_destructor
 		: public integral_constant<bool, __has_virtual_destructor(_T)> {};
@@ -1751,7 +1761,7 @@ namespace gnu_type_traits {
 	struct __is_destructible_safe<Tp, false, true>
 		: public true_type { };
 
-	/// is_destructiable : Ƿܹ  deleted/protected/private
+	/// is_destructiable : 是否能够完成 析构（析构函数不能是 deleted/protected/private）；
 	template<typename Tp>
 	struct is_destructible
 		: public __is_destructible_safe<Tp>::type
@@ -1800,7 +1810,7 @@ namespace gnu_type_traits {
 		: public __is_default_constructible_atom<Tp>::type
 	{ };
 
-	/// is_default_constructible : Ƿܹ ĬϹ죻
+	/// is_default_constructible : 是否能够完成 默认构造；
 	template<typename Tp>
 	struct is_default_constructible
 		: public __is_default_constructible_safe<Tp>::type
@@ -1809,16 +1819,16 @@ namespace gnu_type_traits {
 
 
 
-	/// is_copy_constructible : ǹܹ 죻
+	/// is_copy_constructible : 是够能够完成 拷贝构造；
 
 
-	/// is_move_constructible : Ƿܹ ƶ죻
+	/// is_move_constructible : 是否能够完成 移动构造；
 
 
-	/// is_copy_assignable : Ƿܹ ֵ
+	/// is_copy_assignable : 是否能够完成 拷贝赋值；
 
 
-	/// is_move_assignable : Ƿܹ ƶֵ
+	/// is_move_assignable : 是否能够完成 移动赋值；
 
 
 	template<typename _T1, typename _T2>
@@ -1826,7 +1836,7 @@ namespace gnu_type_traits {
 	template<typename _T>
 	struct is_same<_T, _T> : true_type {};
 
-	/// is_base_of <T1,T2> : T1 Ƿ T2  base class
+	/// is_base_of <T1,T2> : T1 是否是 T2 的 base class；
 	template<typename _Base, typename _Derived>
 	struct is_base_of
 		: public integral_constant<bool, __is_base_of(_Base, _Derived)> {};
@@ -1838,7 +1848,7 @@ namespace gnu_type_traits {
 	template<typename _From, typename _To>
 	class __is_convertible_helper<_From, _To, false> {
 		template<typename _T>
-		static void __test_aux(_T); // жǷͿתΪ_T
+		static void __test_aux(_T); // 判断是否函数参数类型可以转化为_T的类型
 
 		template<typename _From, typename _To,
 			typename = decltype(__test_aux<_To>(declval<_From>()))>
@@ -1849,7 +1859,7 @@ namespace gnu_type_traits {
 		typedef decltype(__test<_From, _To>(0)) type;
 	};
 
-	/// is_convertible <T1,T2> : T1 Ƿת T2
+	/// is_convertible <T1,T2> : T1 是否可转换成 T2；
 	template<typename _From, typename _To>
 	struct is_convertible : __is_convertible_helper<_From, _To>::type {};
 
@@ -1902,33 +1912,33 @@ namespace gnu_type_traits {
 		: public __is_nt_destructible_safe<Tp>::type
 	{ };
 
-	/// remove_const : ȥ const ͣ
+	/// remove_const : 去掉 const 的类型；
 	template<typename _T>
 	struct remove_const { typedef _T type; };
 	template<typename _T>
 	struct remove_const<const _T> { typedef _T type; };
 
-	/// remove_volatile : ȥ volatile ͣ
+	/// remove_volatile : 去掉 volatile 的类型；
 	template<typename _T>
 	struct remove_volatile { typedef _T type; };
 	template<typename _T>
 	struct remove_volatile<volatile _T> { typedef _T type; };
 
-	/// remove_cv : ȥ const  volatile ͣ
+	/// remove_cv : 去掉 const 和 volatile 的类型；
 	template<typename _T>
 	struct remove_cv {
 		typedef typename remove_const<typename remove_volatile<_T>::type>::type type;
 	};
 
-	/// add_const :  const ͣ
+	/// add_const : 带 const 的类型；
 	template<typename _T>
 	struct add_const { typedef _T const type; };
 
-	/// add_volatile :  volatile ͣ
+	/// add_volatile : 带 volatile 的类型；
 	template<typename _T>
 	struct add_volatile { typedef _T volatile type; };
 
-	/// add_cv :  const  volatile ͣ
+	/// add_cv : 带 const 和 volatile 的类型；
 	template<typename _T>
 	struct add_cv {
 		typedef typename add_const<typename add_volatile<_T>::type>::type type;
@@ -2009,8 +2019,8 @@ namespace gnu_type_traits {
 		typedef typename conditional<__b0, __smallest, __cond1_type>::type __type;
 	};
 
-	/// make_unsigned : Ӧ unsigned noreference ͣ
-	template<typename Tp>  // ʹ gcc 4.9 涨巽
+	/// make_unsigned : 对应 unsigned noreference 的类型；
+	template<typename Tp>  // 使用 gcc 4.9 版定义方法
 	struct make_unsigned { typedef typename __make_unsigned_selector<Tp>::__type type; };
 	// Integral, but don't define.
 	template<>
@@ -2062,8 +2072,8 @@ namespace gnu_type_traits {
 		typedef typename conditional<__b0, __smallest, __cond1_type>::type __type;
 	};
 
-	/// make_signed : Ӧ signed noreference ͣ
-	template<typename Tp>  // ʹ gcc 4.9 涨巽
+	/// make_signed : 对应 signed noreference 的类型；
+	template<typename Tp>  // 使用 gcc 4.9 版定义方法
 	struct make_signed {
 		typedef typename __make_signed_selector<Tp>::__type type;
 	};
@@ -2071,7 +2081,7 @@ namespace gnu_type_traits {
 	template<>
 	struct make_signed<bool>;
 
-	/// remove_reference : Ӧ noreference ͣ
+	/// remove_reference : 对应 noreference 类型；
 	template<typename _T>
 	struct remove_reference { typedef _T type; };
 	template<typename _T>
@@ -2079,10 +2089,10 @@ namespace gnu_type_traits {
 	template<typename _T>
 	struct remove_reference<_T&&> { typedef _T type; };
 
-	/// Ƿ ãͰ
+	/// 是否是 可引用，可引用类型包括：
 	template<typename _T>
 	struct __is_referenceable : public __or_<is_object<_T>, is_reference<_T>>::type {};
-	// ƫػ
+	// 函数类型偏特化
 	template<typename _Ret, typename...Args>
 	struct __is_referenceable<_Ret(Args...)> : public true_type {};
 	template<typename _Ret, typename...Args>
@@ -2093,7 +2103,7 @@ namespace gnu_type_traits {
 	template<typename _T>
 	struct __add_lvalue_reference_helper<_T, true> { typedef _T& type; };
 
-	/// add_lvalue_reference : Ӧ ֵãֵֵ
+	/// add_lvalue_reference : 对应 左值引用（右值变左值）；
 	template<typename _T>
 	struct add_lvalue_reference : public __add_lvalue_reference_helper<_T> {};
 
@@ -2102,7 +2112,7 @@ namespace gnu_type_traits {
 	template<typename _T>
 	struct __add_rvalue_reference_helper<_T, true> { typedef _T&& type; };
 
-	/// add_rvalue_reference : Ӧ ֵãֵ䣩
+	/// add_rvalue_reference : 对应 右值引用（左值不变）；
 	template<typename _T>
 	struct add_rvalue_reference : public __add_rvalue_reference_helper<_T> {};
 
@@ -2111,8 +2121,8 @@ namespace gnu_type_traits {
 	template<typename _T, typename _U>
 	struct __remove_pointer_helper<_T, _U*> { typedef _U type; };
 
-	/// remove_pointer : pointer ָͣǷpointer,ԭͣԳԱָ벻ã
-	/// ȥԱָ ָ
+	/// remove_pointer : pointer 所指向的类型（若是非pointer,则是原类型）（对成员指针不起作用）；
+	/// 不能去掉成员指针的 指针属性
 	template<typename _T>
 	struct remove_pointer : __remove_pointer_helper<_T, typename remove_cv<_T>::type> {};
 
@@ -2120,12 +2130,12 @@ namespace gnu_type_traits {
 	struct __add_pointer_helper { typedef _T type; };
 	template<typename _T>
 	struct __add_pointer_helper<_T, true> { typedef typename remove_reference<_T>::type* type; };
-	/// add_pointer : һ pointer ָͣӦ noreference ͣгԱã
-	/// ͺvoidָ
+	/// add_pointer : 一个 pointer 类型，指向对应 noreference 类型（对类中成员不起作用）；
+	/// 向可引用类型和void类型添加指针
 	template<typename _T>
 	struct add_pointer : __add_pointer_helper<_T> {};
 
-	/// rank <T> : array ͵άȣ0
+	/// rank <T> : array 类型的维度（或是0）
 	template<typename _T>
 	struct rank : integral_constant<std::size_t, 0> {};
 	template<typename _T>
@@ -2133,7 +2143,7 @@ namespace gnu_type_traits {
 	template<typename _T, std::size_t _Size>
 	struct rank<_T[_Size]> : integral_constant<std::size_t, 1 + rank<_T>::value> {};
 
-	/// extent <T,I=0> : άI0ĳ߶ȣextent
+	/// extent <T,I=0> : 维度I（或0）的尺度（extent）；
 	template<typename _T, unsigned _I>
 	struct extent : public integral_constant<std::size_t, 0> {};
 	template<typename _T, unsigned _I, std::size_t _Size>
@@ -2143,7 +2153,7 @@ namespace gnu_type_traits {
 	struct extent<_T[], _I> : public integral_constant < std::size_t,
 		_I == 0 ? 0 : extent<_T, _I - 1>::value> {};
 
-	/// remove_extent <T> :  array ԪͣTarrayT
+	/// remove_extent <T> : 获得 array 的元素类型（若T不是array则获得类型T）；
 	template<typename _T>
 	struct remove_extent { typedef _T type; };
 	template<typename _T>
@@ -2151,7 +2161,7 @@ namespace gnu_type_traits {
 	template<typename _T, std::size_t _Size>
 	struct remove_extent<_T[_Size]> { typedef _T type; };
 
-	/// remove_all_extents <T> : öά array ԪͣTǶάarrayT
+	/// remove_all_extents <T> : 获得多维 array 的元素类型（若T不是多维array则获得类型T）；
 	template<typename _T>
 	struct remove_all_extents { typedef _T type; };
 	template<typename _T>
@@ -2159,7 +2169,7 @@ namespace gnu_type_traits {
 	template<typename _T, std::size_t _Size>
 	struct remove_all_extents<_T[_Size]> { typedef typename remove_all_extents<_T>::type type; };
 
-	/// underlying_type <T> : ö͵ĵͲͣ
+	/// underlying_type <T> : 枚举类型的低层类型；
 	template<typename Tp>
 	struct underlying_type { typedef __underlying_type(Tp) type; };
 
@@ -2172,24 +2182,24 @@ namespace gnu_type_traits {
 	template<typename _T>
 	struct __decay_helper<_T, false, true> { typedef typename add_pointer<_T>::type type; };
 
-	/// decay <T> :  T תΪ ʵֵ͡"by-value" type
-	/// ͨͽȥ /const/volatile,    ȥûתΪӦָͣ
+	/// decay <T> : 将 T 转化为 “实值类型”（"by-value" type）；
+	/// 普通类型将会去掉 引用/const/volatile, 函数类型 和 内置数组类型 去掉引用会转化为相应指针类型；
 	template<typename _T>
 	struct decay : __decay_helper<typename remove_reference<_T>::type> {};
 
-	/// enable_if <B,T=void> : ֻе bool B Ϊ true ʱ type T
+	/// enable_if <B,T=void> : 只有当 bool B 为 true 时会产出 type T；
 	template<bool, typename _T = void>
 	struct enable_if {};
 	template<typename _T>
 	struct enable_if<true, _T> { typedef _T type; };
 
-	/// conditional <B,T,F> :  bool B Ϊ true  type T type F
+	/// conditional <B,T,F> : 当 bool B 为 true 会产出 type T，否则产出 type F；
 	template<bool, typename _IfTrue, typename _IfFalse>
 	struct conditional { typedef _IfTrue type; };
 	template<typename _IfTrue, typename _IfFalse>
 	struct conditional<false, _IfTrue, _IfFalse> { typedef _IfFalse type; };
 
-	// ģ
+	// 辅助模板类
 	template<typename _T>
 	struct __success_type { typedef _T type; };
 	struct __failure_type {};
@@ -2198,16 +2208,16 @@ namespace gnu_type_traits {
 	struct __declval_protector
 	{
 		static const bool __stop = false;
-		static typename add_rvalue_reference<Tp>::type __delegate(); // һֵõľ̬Ա
+		static typename add_rvalue_reference<Tp>::type __delegate(); // 声明一个返回右值引用的静态成员函数
 	};
 
 	template<typename Tp>
-	inline typename add_rvalue_reference<Tp>::type  // ԭ _Tp
-		declval() noexcept   // ܱ  ʹãdecltype(declval<_Tp>())  _Tp 
+	inline typename add_rvalue_reference<Tp>::type  // 保持原类型 _Tp
+		declval() noexcept   // 不能被调用  使用：decltype(declval<_Tp>()) 返回 _Tp 类型
 	{
 		static_assert(__declval_protector<Tp>::__stop,
 			"declval() must not be used!");
-		return __declval_protector<Tp>::__delegate();  // ֻкͷֵͼ
+		return __declval_protector<Tp>::__delegate();  // 只进行函数参数和返回值类型检查
 	}
 
 	template<typename...>
@@ -2218,8 +2228,8 @@ namespace gnu_type_traits {
 		template<typename Tp, typename _Up>
 		static __success_type<typename decay<decltype
 		(true ? declval<Tp>()
-			: declval<_Up>())>::type> _S_test(int); // _Tp  _Up йͨʱͨ  __success_type 
-		// __success_type::type Ϊ ͨͣʵֵ
+			: declval<_Up>())>::type> _S_test(int); // _Tp 与 _Up 有共通类型时编译通过 返回 __success_type 
+		// __success_type::type 为 共通类型（“实值”）
 		template<typename, typename>
 		static __failure_type _S_test(...);
 	};
@@ -2234,7 +2244,7 @@ namespace gnu_type_traits {
 	struct __do_member_type_wrapper
 	{
 		template<typename Tp>
-		static __success_type<typename Tp::type> _S_test(int); // _Tp  __success_type ͨ
+		static __success_type<typename Tp::type> _S_test(int); // _Tp 是 __success_type 编译通过
 
 		template<typename>
 		static __failure_type _S_test(...);
@@ -2259,7 +2269,7 @@ namespace gnu_type_traits {
 		typedef __failure_type type;
 	};
 
-	/// common_type <T,...> : б͵Ĺͨͣ
+	/// common_type <T,...> : 所有被传入类型的共通类型；
 	template<typename Tp>
 	struct common_type<Tp>
 	{
@@ -2278,7 +2288,7 @@ namespace gnu_type_traits {
 	{ };
 
 
-	/// result_of <F,Arg> :  Arg Ϊʵε F ýͣ
+	/// result_of <F,Arg> : 将 Arg 作为实参调用 F 后，其所得结果的类型；
 	template<typename _Signature>
 	class result_of;
 
@@ -2363,12 +2373,12 @@ namespace gnu_type_traits {
 
 	template<typename _Res, typename _Class, typename _Arg>
 	struct __result_of_memobj<_Res _Class::*, _Arg>
-	{//  _Res _Class::* Աָͣ _Res ָָͣ_Class Աָࣨͻͣ _Arg 
+	{//  _Res _Class::* 成员指针类型， _Res 指针所指向的类型，_Class 成员指针所属类（对象类型或对象基类类型） _Arg 对象类型
 		typedef typename remove_cv<typename remove_reference<
 			_Arg>::type>::type _Argval;
 		typedef _Res _Class::* _MemPtr;
 		typedef typename conditional<__or_<is_same<_Argval, _Class>,
-			is_base_of<_Class, _Argval>>::value,  // value ֵΪ false ˵  ָ룬 deref İ汾
+			is_base_of<_Class, _Argval>>::value,  // value 的值为 false 则说明 对象的类型是 指针，调用 deref 的版本
 			__result_of_memobj_ref<_MemPtr, _Arg>,
 			__result_of_memobj_deref<_MemPtr, _Arg>
 			>::type::type type;
@@ -2396,12 +2406,12 @@ namespace gnu_type_traits {
 		typedef __failure_type type;
 	};
 
-	template<typename _MemPtr, typename _Arg>  // Ա obj.data 
+	template<typename _MemPtr, typename _Arg>  // 对象成员返回 obj.data 的类型
 	struct __result_of_impl<true, false, _MemPtr, _Arg>
 		: public __result_of_memobj<typename decay<_MemPtr>::type, _Arg>
 	{ };
 
-	template<typename _MemPtr, typename _Arg, typename... _Args>  // 󷽷 obj.fun(args...)
+	template<typename _MemPtr, typename _Arg, typename... _Args>  // 对象方法调用 obj.fun(args...)
 	struct __result_of_impl<false, true, _MemPtr, _Arg, _Args...>
 		: public __result_of_memfun<typename decay<_MemPtr>::type, _Arg, _Args...>
 	{ };
@@ -2418,7 +2428,7 @@ namespace gnu_type_traits {
 		static __failure_type _S_test(...);
 	};
 
-	template<typename _Functor, typename... _ArgTypes>  // ͨ fun(args...)
+	template<typename _Functor, typename... _ArgTypes>  // 函数对象和普通函数调用 fun(args...)
 	struct __result_of_impl<false, false, _Functor, _ArgTypes...>
 		: private __result_of_other_impl
 	{
@@ -2437,12 +2447,12 @@ namespace gnu_type_traits {
 
 
 
-	/// aligned_of <T> : ȼ alignof(T)
+	/// aligned_of <T> : 等价于 alignof(T)；
 
 
-	/// aligned_sotrage <Len> : Len byte Ĭ϶ɵͣ
-	/// aligned_storage <Len,Align> : Len byte  size_t Align Լж룬ɵͣ
-	/// aligned_union <Len,Types...> : Len byte  a union of Types... ж룬ɵͣ
+	/// aligned_sotrage <Len> : Len byte 加上默认对齐规则所可容纳的类型；
+	/// aligned_storage <Len,Align> : Len byte 且以 size_t Align 的约数进行对齐，所可容纳的类型；
+	/// aligned_union <Len,Types...> : Len byte 且以 a union of Types... 进行对齐，所可容纳的类型；
 
 
 	template<typename Tp>
@@ -2469,7 +2479,7 @@ namespace gnu_type_traits {
 	};
 
 
-	/// ģ
+	/// 模板别名
 	// 
 	/// remove_pointer_t
 	template<typename _T>
@@ -2480,15 +2490,15 @@ namespace gnu_type_traits {
 	using add_pointer_t = typename add_pointer<_T>::type;
 
 
-	// Note
-	// true_type/false_type ʵ
-	// ͵ıʾ͡Աָ
-	// ģض塢ݹƫػ
-	// make_signed/make_unsigned ʵּ
-	// declvalʵ֡decltype()
-	// __test(int)/__test(...) ģ庯ƥ
-	// common_type / result_of ʵ
-	// is_nothrow_destructible ʵ
+	// Note：
+	// true_type/false_type 的实现
+	// 类型的表示、函数类型、成员指针
+	// 模板重定义、递归和偏特化
+	// make_signed/make_unsigned 的实现技巧
+	// declval函数的实现、decltype()
+	// __test(int)/__test(...) 模板函数的匹配
+	// common_type / result_of 的实现
+	// is_nothrow_destructible 的实现
 	// <functional> reference wrapper for make_pair
 
 	//struct B
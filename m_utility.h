@@ -106,11 +106,11 @@ namespace mstd {
 		using _Reftype = mstd::conditional_t<mstd::is_void_v<element_type>, char, element_type>&;
 
 		static pointer pointer_to(_Reftype val) noexcept(noexcept(Tp::pointer_to(val))) {
-			return Tp::pointer_to(val);  // fancy pointer Tpжpointer_to()ķֵЩpointerжpointer_to()??
+			return Tp::pointer_to(val);  // 返回fancy pointer Tp中定义的pointer_to()函数的返回值，有哪些pointer中定义了pointer_to()函数??
 		}
 	};
 
-	template<class Tp>	// ԭָ plain pointer
+	template<class Tp>	// 原生指针 plain pointer
 	struct pointer_traits<Tp*> {
 
 		using pointer = Tp*;
@@ -149,7 +149,7 @@ namespace mstd {
 	// copy(); copy_n(); copy_backward(); move(); move_backward(); fill(); fill_n(); equal(); 
 	// lexicographical_compare; find(); count(); reverse(); rotate(); find_if(); 
 
-	// ʵstd::memmove(); std::memcpy();
+	// 实现std::memmove(); std::memcpy();
 	/*
 	void* memcpy(void *dst, const void *src, size_t count);
 	void* memmove(void *dst, const void *src, size_t count);
@@ -189,7 +189,7 @@ namespace mstd {
 		return val;
 	}
 
-	template<class Iter>  // move_iterator<>ƫػ
+	template<class Iter>  // move_iterator<>偏特化，
 	constexpr auto _To_address(const move_iterator<Iter>& val) noexcept {
 		return _To_address(val.base());
 	}
@@ -222,7 +222,7 @@ namespace mstd {
 
 	template<class Source, class Dest, class SourceRef, class DestRef>
 	struct _Trivial_cat {
-		using USource = _Unwrap_enum_t<Source>;  // ΪʲôҪUnwrap_enum??
+		using USource = _Unwrap_enum_t<Source>;  // 为什么要Unwrap_enum??
 		using UDest = _Unwrap_enum_t<Dest>;
 
 		static constexpr bool _Same_size_and_compatible = sizeof(Source) == sizeof(Dest)
@@ -286,15 +286,15 @@ namespace mstd {
 	template<class InIter, class OutIter>
 	OutIter _Copy_with_memmove(InIter first, InIter last, OutIter dest) {
 		auto firstPtr = _To_address(first);
-		auto lastPtr = _To_address(first);
-		auto destPtr = _To_address(first);
+		auto lastPtr = _To_address(last);
+		auto destPtr = _To_address(dest);
 		const char* const first_ch = const_cast<const char*>(reinterpret_cast<const volatile char*>(firstPtr));
 		const char* const last_ch = const_cast<const char*>(reinterpret_cast<const volatile char*>(lastPtr));
 		char* const dest_ch = const_cast<char*>(reinterpret_cast<const volatile char*>(destPtr));
 		const auto count = static_cast<size_t>(last_ch - first_ch);
 		mstd::memmove(dest_ch, first_ch, count);
 		if constexpr (is_pointer_v<OutIter>) {
-			return reinterpret_cast<OutIter>(destPtr + count);
+			return reinterpret_cast<OutIter>(dest_ch + count);
 		}
 		else {
 			return dest + (lastPtr - firstPtr);
@@ -331,6 +331,23 @@ namespace mstd {
 	template<class InIter, class OutIter>
 	inline OutIter copy(InIter first, InIter last, OutIter dest) {
 		_Mstd_adl_verify_range(first, last);
+		if constexpr (_Is_segmented_iter_v<InIter>) {	// 按源区间的块逐段复制
+			_Visit_segments(first, static_cast<size_t>(last - first), [&dest](auto ptr, const size_t num) {
+				dest = mstd::copy(ptr, ptr + num, dest);
+				return num;
+			});
+			return dest;
+		}
+		else if constexpr (_Is_segmented_iter_v<OutIter> && _Is_any_rdm_iter_v<InIter>) {	// 按目标区间的块逐段复制
+			const auto count = static_cast<size_t>(last - first);
+			_Visit_segments(dest, count, [&first](auto ptr, const size_t num) {
+				const auto next = first + static_cast<_Iter_difference_t<InIter>>(num);
+				mstd::copy(first, next, ptr);
+				first = next;
+				return num;
+			});
+			return dest + static_cast<_Iter_difference_t<OutIter>>(count);
+		}
 		const auto ufirst = _Get_unwrapped_iter(first);
 		const auto ulast = _Get_unwrapped_iter(last);
 		const auto udest = _Get_unwrapped_iter_n(dest, _Get_distance<InIter>(last, last));
@@ -367,8 +384,8 @@ namespace mstd {
 	template<class BidIter1, class BidIter2>
 	BidIter2 _Copy_backward_with_memmove(BidIter1 first, BidIter1 last, BidIter2 dest) {
 		auto firstPtr = _To_address(first);
-		auto lastPtr = _To_address(first);
-		auto destPtr = _To_address(first);
+		auto lastPtr = _To_address(last);
+		auto destPtr = _To_address(dest);
 		const char* const first_ch = const_cast<const char*>(reinterpret_cast<const volatile char*>(firstPtr));
 		const char* const last_ch = const_cast<const char*>(reinterpret_cast<const volatile char*>(lastPtr));
 		char* const dest_ch = const_cast<char*>(reinterpret_cast<const volatile char*>(destPtr));
@@ -378,7 +395,7 @@ namespace mstd {
 			return reinterpret_cast<BidIter2>(result);
 		}
 		else {
-			return dest + (lastPtr - firstPtr);
+			return dest - (lastPtr - firstPtr);
 		}
 	}
 
@@ -422,6 +439,23 @@ namespace mstd {
 	template<class InIter, class OutIter>
 	inline OutIter move(InIter first, InIter last, OutIter dest) {
 		_Mstd_adl_verify_range(first, last);
+		if constexpr (_Is_segmented_iter_v<InIter>) {
+			_Visit_segments(first, static_cast<size_t>(last - first), [&dest](auto ptr, const size_t num) {
+				dest = mstd::move(ptr, ptr + num, dest);
+				return num;
+			});
+			return dest;
+		}
+		else if constexpr (_Is_segmented_iter_v<OutIter> && _Is_any_rdm_iter_v<InIter>) {
+			const auto count = static_cast<size_t>(last - first);
+			_Visit_segments(dest, count, [&first](auto ptr, const size_t num) {
+				const auto next = first + static_cast<_Iter_difference_t<InIter>>(num);
+				mstd::move(first, next, ptr);
+				first = next;
+				return num;
+			});
+			return dest + static_cast<_Iter_difference_t<OutIter>>(count);
+		}
 		const auto ufirst = _Get_unwrapped_iter(first);
 		const auto ulast = _Get_unwrapped_iter(last);
 		const auto udest = _Get_unwrapped_iter_n(dest, _Get_distance<InIter>(ufirst, ulast));
@@ -505,6 +539,13 @@ namespace mstd {
 	template<class FwdIter, class Tp>
 	inline void fill(const FwdIter first, const FwdIter last, const Tp& val) {
 		_Mstd_adl_verify_range(first, last);
+		if constexpr (_Is_segmented_iter_v<FwdIter>) {	// 每块走 memset 或逐个赋值
+			_Visit_segments(first, static_cast<size_t>(last - first), [&val](auto ptr, const size_t num) {
+				mstd::fill(ptr, ptr + num, val);
+				return num;
+			});
+			return;
+		}
 		auto ufirst = _Get_unwrapped_iter(first);
 		const auto ulast = _Get_unwrapped_iter(last);
 		if constexpr (_Fill_memset_is_safe<decltype(ufirst), Tp>) {
@@ -525,6 +566,13 @@ namespace mstd {
 	template<class OutIter, class Diff, class Tp>
 	inline OutIter fill_n(OutIter dest, const Diff count_raw, const Tp& val) {
 		_Algorithm_int_t<Diff> count = count_raw;
+		if constexpr (_Is_segmented_iter_v<OutIter>) {
+			if (count > 0) {
+				mstd::fill(dest, dest + static_cast<_Iter_difference_t<OutIter>>(count), val);
+				dest += static_cast<_Iter_difference_t<OutIter>>(count);
+			}
+			return dest;
+		}
 		if (count > 0) {
 			auto udest = _Get_unwrapped_iter_n(dest, count);
 			if constexpr (_Fill_memset_is_safe<decltype(udest), Tp>) {
@@ -4,19 +4,28 @@
 #include <exception>			// std::out_of_range;
 #include <cstring>				// std::memmove();
 #include <type_traits>			// std::enable_if_t<>;
+#include <iterator>				// std::forward_iterator_tag; std::begin();
 
 #include "m_alloc.h"			// malloc_allocator;
+#include "m_memory.h"			// allocator_traits; _Compressed_pair; _Uninitialized_copy();
+#include "m_memory_resource.h"	// pmr::polymorphic_allocator;
 #include "m_constructor.h"		// construct(); destroy();
 #include "m_utility.h"			// is_iterator_v<>;
 #include "m_algorithm.h"		// copy();
-#include "m_iterator.h"			// reverse_iterator;
+#include "m_iterator.h"			// reverse_iterator; _MSTD_HARDENED_CHECK();
 
 
 
 namespace mstd {
 
+	template<typename VecType, typename = void>
+	constexpr bool _Has_scary_val_v = false;
+
+	template<typename VecType>
+	constexpr bool _Has_scary_val_v<VecType, void_t<typename VecType::_Scary_val>> = true;
+
 	template<typename VecType>
-	struct _vector_const_iterator {
+	struct _vector_const_iterator : _Iterator_base {
 
 		using iterator_category = std::random_access_iterator_tag;
 		using value_type = typename VecType::value_type;
@@ -31,13 +40,22 @@ namespace mstd {
 
 		_vector_const_iterator() noexcept = default;
 		_vector_const_iterator(val_ptr_t ptr) noexcept : ptr_(ptr) {}
+		_vector_const_iterator(val_ptr_t ptr, const _Container_base* cont) noexcept : ptr_(ptr) {
+			this->_Adopt(cont);
+		}
 		_vector_const_iterator& operator=(val_ptr_t ptr) noexcept {
 			this->ptr_ = ptr;
 			return *this;
 		}
 
-		reference operator*() const noexcept { return *ptr_; }
-		pointer operator->() const noexcept { return ptr_; }
+		reference operator*() const noexcept {
+			_Verify_deref();
+			return *ptr_;
+		}
+		pointer operator->() const noexcept {
+			_Verify_deref();
+			return ptr_;
+		}
 		_vector_const_iterator& operator++() noexcept {
 			++ptr_;
 			return *this;
@@ -61,7 +79,9 @@ namespace mstd {
 		}
 
 		_vector_const_iterator operator+(const difference_type off) const noexcept {
-			return _vector_const_iterator(ptr_ + off);
+			_vector_const_iterator temp = *this;
+			temp += off;
+			return temp;
 		}
 
 		_vector_const_iterator& operator+=(const difference_type off) noexcept {
@@ -70,7 +90,9 @@ namespace mstd {
 		}
 
 		_vector_const_iterator operator-(const difference_type off) const noexcept {
-			return _vector_const_iterator(ptr_ - off);
+			_vector_const_iterator temp = *this;
+			temp -= off;
+			return temp;
 		}
 
 		_vector_const_iterator& operator-=(const difference_type off) noexcept {
@@ -107,13 +129,26 @@ namespace mstd {
 
 		val_ptr_t raw_ptr() const noexcept { return ptr_; }
 
+		// _ITERATOR_DEBUG 下检查迭代器没有因扩容、清空而失效，并且指向有效元素
+		void _Verify_deref() const noexcept {
+#if _ITERATOR_DEBUG
+			this->_Verify_current("vector iterator invalidated");
+			if constexpr (_Has_scary_val_v<VecType>) {	// small_vector 等复用本迭代器的容器不绑定迭代器
+				if (const auto cont = this->_Getcont()) {
+					const auto& data = static_cast<const typename VecType::_Scary_val&>(*cont);
+					_MSTD_VERIFY(data.start_.ptr_ <= ptr_ && ptr_ < data.finish_.ptr_, "vector iterator not dereferencable");
+				}
+			}
+#endif // _ITERATOR_DEBUG
+		}
+
 	};
 
 	template<typename Tp>
 	inline _vector_const_iterator<Tp>
 		operator+(typename _vector_const_iterator<Tp>::difference_type off,
 			const _vector_const_iterator<Tp>& right) noexcept {
-		return _vector_const_iterator<Tp>(right.ptr_ + off);
+		return right + off;
 	}
 
 	template<typename VecType>
@@ -125,9 +160,10 @@ namespace mstd {
 
 		_vector_iterator() noexcept = default;
 		_vector_iterator(pointer ptr) noexcept : Parent(ptr) {}
-		_vector_iterator(const Parent& right) noexcept : Parent(right.raw_ptr()) {}
+		_vector_iterator(pointer ptr, const _Container_base* cont) noexcept : Parent(ptr, cont) {}
+		_vector_iterator(const Parent& right) noexcept : Parent(right) {}
 		_vector_iterator& operator=(const Parent& right) noexcept {
-			this->ptr_ = right.ptr_;
+			Parent::operator=(right);
 			return *this;
 		}
 
@@ -173,7 +209,7 @@ namespace mstd {
 
 		using Parent::operator-;
 
-		_vector_iterator operator-(const difference_type off) noexcept {
+		_vector_iterator operator-(const difference_type off) const noexcept {
 			_vector_iterator temp = *this;
 			temp -= off;
 			return temp;
@@ -184,7 +220,7 @@ namespace mstd {
 			return *this;
 		}
 
-		_vector_iterator operator+(const difference_type off) noexcept {
+		_vector_iterator operator+(const difference_type off) const noexcept {
 			_vector_iterator temp = *this;
 			temp += off;
 			return temp;
@@ -195,14 +231,74 @@ namespace mstd {
 	template<typename Tp>
 	inline _vector_iterator<Tp> operator+(const typename _vector_iterator<Tp>::difference_type off,
 		const _vector_iterator<Tp>& right) noexcept {
-		return _vector_iterator<Tp>{right.ptr_ + off};
+		return right + off;
 	}
 
+	// vector 的扩容策略，next_capacity(cap, need, elem_size) 返回不小于 need 的新容量
+	// name 用于统计和基准测试的输出
+	struct vector_growth_2x {
+		static constexpr const char* name = "2x";
+		static constexpr size_t next_capacity(size_t cap, size_t need, size_t) noexcept {
+			return 2 * cap > need ? 2 * cap : need;
+		}
+	};
+
+	// 多一次扩容换取更少的空闲容量，且释放的旧内存之和有机会被后续扩容重用
+	struct vector_growth_1_5x {
+		static constexpr const char* name = "1.5x";
+		static constexpr size_t next_capacity(size_t cap, size_t need, size_t) noexcept {
+			return cap + cap / 2 > need ? cap + cap / 2 : need;
+		}
+	};
+
+	// 2x 扩容后把字节数上调到 Page 的整数倍，不足一页时不调整，适合 page_allocator 一类按页分配的分配器
+	template<size_t Page = 4096>
+	struct vector_growth_page {
+		static_assert(Page > 0 && (Page & (Page - 1)) == 0, "Page must be a power of two.");
+		static constexpr const char* name = "page";
+		static constexpr size_t next_capacity(size_t cap, size_t need, size_t elem_size) noexcept {
+			const size_t n = vector_growth_2x::next_capacity(cap, need, elem_size);
+			if (n * elem_size < Page) { return n; }
+			return ((n * elem_size + Page - 1) & ~(Page - 1)) / elem_size;
+		}
+	};
+
+	// 1.5x 扩容，分配后把容量扩大到 malloc 实际给出的大小，空闲容量不再浪费在分配器内部
+	// 只对直接使用 malloc_allocator 的 vector 生效，其余分配器按 1.5x 处理
+	struct vector_growth_usable_size : vector_growth_1_5x {
+		static constexpr const char* name = "usable_size";
+		static constexpr bool use_usable_size = true;
+	};
+
+	template<class Growth, class = void>
+	struct _Growth_uses_usable_size : false_type {};
+
+	template<class Growth>
+	struct _Growth_uses_usable_size<Growth, void_t<decltype(Growth::use_usable_size)>>
+		: bool_constant<Growth::use_usable_size> {};
+
+	// 某个 vector 类型的扩容统计，计数需要开启 _MSTD_ALLOC_STATS
+	struct vector_growth_stats {
+		const char* policy = "";
+		size_t grows = 0;		// 因容量不足重新分配的次数
+		size_t relocated = 0;	// 扩容时搬移的元素个数
+		size_t bytes = 0;		// 扩容后的容量字节数之和
+	};
 
-	template<typename Tp, typename Alloc = malloc_allocator<0>>
+	template<typename Tp, typename Alloc = malloc_allocator<0>, typename Growth = vector_growth_2x>
 	class vector {
+	private:
+		// 元素分配器，按字节分配的静态分配器由 simple_alloc 包装
+		using _Alty = _Container_alloc_t<Alloc, Tp>;
+		using _Alty_traits = allocator_traits<_Alty>;
+
 	public:
+		static_assert(mstd::is_same_v<typename _Alty_traits::pointer, Tp*>,
+			"vector does not support allocators with fancy pointers.");
+
 		using data_allocator = Alloc;
+		using allocator_type = _Alty;
+		using growth_policy = Growth;
 		using value_type = Tp;
 		using pointer = value_type*;
 		using reference = value_type&;
@@ -217,87 +313,279 @@ namespace mstd {
 		using const_reverse_iterator = mstd::reverse_iterator<const_iterator>;
 
 	protected:
-		iterator start_{};
-		iterator finish_{};
-		iterator end_of_storage_{};
+		struct _Vector_val : _Container_base {
+			iterator start_{};
+			iterator finish_{};
+			iterator end_of_storage_{};
+		};
+
+		// 分配器与元素区间存放在一起，空分配器不占用空间
+		_Compressed_pair<_Alty, _Vector_val> m_pair_;
+
+	public:
+		using _Scary_val = _Vector_val;	// 供迭代器检查元素区间
+
+	protected:
+
+		_Alty& _Get_alloc() noexcept { return m_pair_._Get_first(); }
+		const _Alty& _Get_alloc() const noexcept { return m_pair_._Get_first(); }
+		_Vector_val& _Get_data() noexcept { return m_pair_.second_; }
+		const _Vector_val& _Get_data() const noexcept { return m_pair_.second_; }
 
-		// nԪصĿռ䣬ԭʧЧ
+		iterator& _Myfirst() noexcept { return m_pair_.second_.start_; }
+		const iterator& _Myfirst() const noexcept { return m_pair_.second_.start_; }
+		iterator& _Mylast() noexcept { return m_pair_.second_.finish_; }
+		const iterator& _Mylast() const noexcept { return m_pair_.second_.finish_; }
+		iterator& _Myend() noexcept { return m_pair_.second_.end_of_storage_; }
+		const iterator& _Myend() const noexcept { return m_pair_.second_.end_of_storage_; }
+
+		// 分配n个元素的空间，原迭代器失效
 		void alloc_n(size_type size) {
-			start_ = static_cast<pointer>
-				(data_allocator::allocate(size * sizeof(value_type)));
-			end_of_storage_ = start_ + size;
+			_Myfirst() = _Alty_traits::allocate(_Get_alloc(), size);
+			_Mylast() = _Myfirst();
+			_Myend() = _Myfirst() + size;
 		}
 
 		void fill_init(size_type n, const value_type& value) {
 			if (0 == n) { return; }
 			alloc_n(n);
-			finish_ = uninitialized_fill_n(start_, n, value);
+			try {
+				_Mylast() = _Uninitialized_fill_n(_Myfirst().raw_ptr(), n, value, _Get_alloc());
+			}
+			catch (...) {
+				_Tidy();
+				throw;
+			}
 		}
 
+		// 标准库容器的迭代器使用 std 的标签，同样可以预先求出长度
+		template <typename Iter>
+		static constexpr bool _Is_sized_iter = _Is_ranges_fwd_iter_v<Iter> ||
+			mstd::is_convertible<_Iter_category_t<Iter>, std::forward_iterator_tag>::value;
+
 		template <typename IptIter>
 		void range_init(IptIter begin, IptIter end) {
-			difference_type n = std::distance(begin, end);
-			if (0 == n) { return; }
-			alloc_n(n);
-			finish_ = uninitialized_copy(begin, end, start_);
+			if constexpr (_Is_sized_iter<IptIter>) {
+				const auto n = static_cast<size_type>(mstd::distance(begin, end));
+				if (0 == n) { return; }
+				alloc_n(n);
+			}
+			try {
+				append_iter(begin, end);
+			}
+			catch (...) {
+				_Tidy();
+				throw;
+			}
+		}
+
+		// 在末尾构造[first, last)，长度已知时最多扩容一次，可按位复制的元素由 _Uninitialized_copy 整块 memcpy
+		// 单趟的输入迭代器无法预先求出长度，按 Growth 逐步扩容
+		template <typename IptIter>
+		void append_iter(IptIter first, IptIter last) {
+			if constexpr (_Is_sized_iter<IptIter>) {
+				check_and_alloc(static_cast<size_type>(mstd::distance(first, last)));
+				_Mylast() = _Uninitialized_copy(first, last, _Mylast().raw_ptr(), _Get_alloc());
+			}
+			else {
+				for (; first != last; ++first) {
+					if (_Mylast() == _Myend()) { check_and_alloc(1); }
+					_Alty_traits::construct(_Get_alloc(), _Mylast().raw_ptr(), *first);
+					++_Mylast();
+				}
+			}
+		}
+
+		// 输入迭代器先读入临时 vector，再整体搬到插入位置，原有元素只移动一次
+		template <typename IptIter>
+		iterator insert_iter(const_iterator pos, IptIter first, IptIter last) {
+			_MSTD_HARDENED_CHECK(!is_invalid_insert_iterator(pos),
+				"vector member func insert() error: iterator out of range");
+			const difference_type index = pos - cbegin();
+			if constexpr (_Is_sized_iter<IptIter>) {
+				const auto num = static_cast<size_type>(mstd::distance(first, last));
+				check_and_alloc(num);
+				iterator new_iter{ _Myfirst() + index };
+				move_backward_n(new_iter, num);
+				_Uninitialized_copy(first, last, new_iter.raw_ptr(), _Get_alloc());
+				return _Make_iter(new_iter.raw_ptr());
+			}
+			else {
+				if (pos == cend()) {
+					append_iter(first, last);
+					return _Make_iter(_Myfirst().raw_ptr() + index);
+				}
+				vector temp(_Get_alloc());
+				temp.append_iter(first, last);
+				const size_type num = temp.size();
+				check_and_alloc(num);
+				iterator new_iter{ _Myfirst() + index };
+				move_backward_n(new_iter, num);
+				_Uninitialized_relocate(temp._Myfirst().raw_ptr(), temp._Mylast().raw_ptr(), new_iter.raw_ptr(), _Get_alloc());
+				temp._Mylast() = temp._Myfirst();
+				return _Make_iter(new_iter.raw_ptr());
+			}
 		}
 
+		// 复用已有的容量，[first, last)不能指向本容器
+		template <typename IptIter>
+		void assign_iter(IptIter first, IptIter last) {
+			clear();
+			if constexpr (_Is_sized_iter<IptIter>) {
+				const auto n = static_cast<size_type>(mstd::distance(first, last));
+				if (n > capacity()) {
+					_Tidy();
+					alloc_n(n);
+				}
+			}
+			append_iter(first, last);
+		}
+
+		// 接管other的元素区间，不涉及分配器，指向other的迭代器随元素一起转移
 		void exchange(vector& other) noexcept {
-			this->start_ = other.start_;
-			this->finish_ = other.finish_;
-			this->end_of_storage_ = other.end_of_storage_;
-			other.start_ = other.finish_ = other.end_of_storage_ = nullptr;
+			_Myfirst() = other._Myfirst();
+			_Mylast() = other._Mylast();
+			_Myend() = other._Myend();
+			other._Myfirst() = other._Mylast() = other._Myend() = nullptr;
+			_Get_data()._Swap_proxy_and_iterators(other._Get_data());
+		}
+
+		// 只交换元素区间，不交换分配器
+		void swap_data(vector& other) noexcept {
+			mstd::swap(_Myfirst(), other._Myfirst());
+			mstd::swap(_Mylast(), other._Mylast());
+			mstd::swap(_Myend(), other._Myend());
+			_Get_data()._Swap_proxy_and_iterators(other._Get_data());
+		}
+
+		// 返回给用户的迭代器绑定到本容器，_ITERATOR_DEBUG 为0时与原始指针相同
+		iterator _Make_iter(pointer ptr) noexcept { return iterator(ptr, std::addressof(_Get_data())); }
+		const_iterator _Make_iter(pointer ptr) const noexcept { return const_iterator(ptr, std::addressof(_Get_data())); }
+
+		// 销毁全部元素并归还内存
+		void _Tidy() noexcept {
+			_Get_data()._Orphan_all();
+			if (_Myfirst().raw_ptr() != nullptr) {
+				_Destroy_range(_Myfirst().raw_ptr(), _Mylast().raw_ptr(), _Get_alloc());
+				_Alty_traits::deallocate(_Get_alloc(), _Myfirst().raw_ptr(), capacity());
+				_Myfirst() = _Mylast() = _Myend() = nullptr;
+			}
+		}
+
+		// 元素可以按字节搬移时，扩容、插入和删除都整块 memcpy/memmove，不再逐个移动构造再析构
+		static constexpr bool _Use_relocate = is_trivially_relocatable_v<value_type>;
+
+		// 再加上分配器提供 reallocate 时，扩容交给分配器的 realloc/mremap，
+		// 能原地扩展时既不复制元素，也不需要同时持有新旧两块内存
+		static constexpr bool _Use_reallocate = _Use_relocate &&
+			_Has_reallocate<_Alty, size_type, pointer>::value;
+
+		// 分配器是 malloc 时，容量可以扩大到 malloc 实际给出的大小
+		static constexpr bool _Use_usable_size = _Growth_uses_usable_size<Growth>::value &&
+			is_same_v<_Alty, simple_alloc<Tp, Alloc>> && _Has_usable_size<Alloc>::value;
+
+		static size_type usable_capacity(pointer p, size_type cap) noexcept {
+			if constexpr (_Use_usable_size) {
+				return Alloc::expand_to_usable(p, cap * sizeof(value_type)) / sizeof(value_type);
+			}
+			else {
+				return cap;
+			}
+		}
+
+		static _Stat_counter stat_grows;
+		static _Stat_counter stat_relocated;
+		static _Stat_counter stat_bytes;
+
+		// 重新分配new_cap个元素的空间并移入原有元素，原迭代器失效
+		void reallocate_n(size_type new_cap) {
+			_Get_data()._Orphan_all();
+			const size_type old_size = size();
+			if constexpr (_Use_reallocate) {
+				if (_Myfirst().raw_ptr() != nullptr) {
+					pointer new_first = _Get_alloc().reallocate(_Myfirst().raw_ptr(), capacity(), new_cap);
+					new_cap = usable_capacity(new_first, new_cap);
+					_Myfirst() = new_first;
+					_Mylast() = new_first + old_size;
+					_Myend() = new_first + new_cap;
+					return;
+				}
+			}
+			pointer new_first = _Alty_traits::allocate(_Get_alloc(), new_cap);
+			try {
+				_Uninitialized_relocate(_Myfirst().raw_ptr(), _Mylast().raw_ptr(), new_first, _Get_alloc());
+			}
+			catch (...) {
+				_Alty_traits::deallocate(_Get_alloc(), new_first, new_cap);
+				throw;
+			}
+			new_cap = usable_capacity(new_first, new_cap);
+			// 原有元素已经搬走，只归还内存
+			if (_Myfirst().raw_ptr() != nullptr) {
+				_Alty_traits::deallocate(_Get_alloc(), _Myfirst().raw_ptr(), capacity());
+			}
+			_Myfirst() = new_first;
+			_Mylast() = new_first + old_size;
+			_Myend() = new_first + new_cap;
 		}
 
-		//nԪصĿռ䣬ʣռ䲻µڴ棬ԭʧЧ
+		//请求n个元素的空间，若剩余空间不足则分配新的内存，原迭代器可能失效
 		void check_and_alloc(size_type n) {
-			if (end_of_storage_ - finish_ >= static_cast<difference_type>(n)) { return; }
-			auto need_sz = 2 * size() > (size() + n) ? 2 * size() : size() + n;
-			vector temp = std::move(*this);
-			alloc_n(need_sz);
-			finish_ = uninitialized_move(temp.begin(), temp.end(), start_);
+			if (_Myend() - _Mylast() >= static_cast<difference_type>(n)) { return; }
+			stat_grows.add();
+			stat_relocated.add(size());
+			reallocate_n(Growth::next_capacity(capacity(), size() + n, sizeof(value_type)));
+			stat_bytes.add(capacity() * sizeof(value_type));
 		}
 
-		//[posfinish)֮Ԫǰƶnλ
+		//将[pos，finish)之间的元素向前移动n个位置
 		void move_forward_n(iterator pos, size_type n) {
 			auto dest = pos - static_cast<difference_type>(n);
-			iterator new_finish = mstd::copy(pos, finish_, dest);
-			if (new_finish < finish_)
-				destroy(new_finish, finish_);
-			finish_ = new_finish;
+			if constexpr (_Use_relocate) {
+				_Destroy_range(dest.raw_ptr(), pos.raw_ptr(), _Get_alloc());
+				std::memmove(static_cast<void*>(dest.raw_ptr()), static_cast<const void*>(pos.raw_ptr()),
+					(_Mylast() - pos) * sizeof(value_type));
+				_Mylast() -= static_cast<difference_type>(n);
+				return;
+			}
+			iterator new_finish = mstd::copy(pos, _Mylast(), dest);
+			if (new_finish < _Mylast())
+				_Destroy_range(new_finish.raw_ptr(), _Mylast().raw_ptr(), _Get_alloc());
+			_Mylast() = new_finish;
 		}
 
-		//[pos,finish)֮Ԫƶnλãpos==finish_++finish_
+		//将[pos,finish)之间的元素向后移动n个位置，finish_后移n个位置，[pos, pos + n)留给调用者构造
 		void move_backward_n(iterator pos, size_type n) {
-			if (pos < finish_) {
-				iterator new_finish = finish_ + n;
+			_Alty& al = _Get_alloc();
+			if (pos < _Mylast()) {
+				iterator new_finish = _Mylast() + n;
 				iterator new_pos = pos + n;
-				if (std::is_pod_v<value_type>) {
-					std::memmove(new_pos.raw_ptr(), pos.raw_ptr(),
-						n * sizeof(value_type));
+				if constexpr (_Use_relocate) {
+					std::memmove(static_cast<void*>(new_pos.raw_ptr()), static_cast<const void*>(pos.raw_ptr()),
+						(_Mylast() - pos) * sizeof(value_type));
 				}
 				else {
-					iterator src{ finish_ }, dst{ new_finish };
-					if (new_pos < finish_) {
-						while (dst != finish_) {
-							mstd::construct(&*--dst, std::move(*--src));
+					iterator src{ _Mylast() }, dst{ new_finish };
+					if (new_pos < _Mylast()) {
+						while (dst != _Mylast()) {
+							_Alty_traits::construct(al, (--dst).raw_ptr(), std::move(*--src));
 						}
 						while (dst != new_pos) {
 							*--dst = std::move(*--src);
 						}
-						destroy(pos, new_pos);
+						_Destroy_range(pos.raw_ptr(), new_pos.raw_ptr(), al);
 					}
 					else {
 						while (dst != new_pos) {
-							mstd::construct(&*--dst, std::move(*--src));
+							_Alty_traits::construct(al, (--dst).raw_ptr(), std::move(*--src));
 						}
-						destroy(pos, finish_);
+						_Destroy_range(pos.raw_ptr(), _Mylast().raw_ptr(), al);
 					}
 				}
-				finish_ = new_finish;
+				_Mylast() = new_finish;
 			}
-			else if (pos == finish_) {
-				++finish_;
+			else if (pos == _Mylast()) {
+				_Mylast() += static_cast<difference_type>(n);
 			}
 		}
 
@@ -306,88 +594,164 @@ namespace mstd {
 		}
 
 		bool is_invalid_iterator(const_iterator pos) const noexcept {
-			return pos < start_ || pos >= finish_;
+			return pos < _Myfirst() || pos >= _Mylast();
 		}
 
 		bool is_invalid_insert_iterator(const_iterator pos) const noexcept {
-			return pos < start_ || pos > finish_;
+			return pos < _Myfirst() || pos > _Mylast();
 		}
 
 	public:
-		vector() noexcept = default;
-		explicit vector(size_type size) { fill_init(size, value_type()); }
-		vector(size_type size, const value_type& value) { fill_init(size, value); }
-		// ʹ mstd::is_iterator_v ù캯רû
+		vector() noexcept(mstd::is_nothrow_default_constructible<_Alty>::value)
+			: m_pair_(_Zero_then_variadic_args_t{}) {}
+		explicit vector(const allocator_type& alloc) noexcept
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {}
+		explicit vector(size_type size, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			fill_init(size, value_type());
+		}
+		vector(size_type size, const value_type& value, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			fill_init(size, value);
+		}
+		// 使用 mstd::is_iterator_v 让构造函数专用化
 		template <typename IptIter, std::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
-		vector(IptIter first, IptIter last) { range_init(first, last); }
-		// ʹ std::initializer_list
-		vector(std::initializer_list<value_type> ilist) { range_init(ilist.begin(), ilist.end()); }
-		vector(const vector& other) { range_init(other.begin(), other.end()); }
+		vector(IptIter first, IptIter last, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			range_init(first, last);
+		}
+		// 使用 std::initializer_list
+		vector(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			range_init(ilist.begin(), ilist.end());
+		}
+		vector(const vector& other)
+			: m_pair_(_One_then_variadic_args_t{}, _Alty_traits::select_on_container_copy_construction(other._Get_alloc())) {
+			range_init(other._Myfirst().raw_ptr(), other._Mylast().raw_ptr());
+		}
+		vector(const vector& other, const allocator_type& alloc)
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			range_init(other._Myfirst().raw_ptr(), other._Mylast().raw_ptr());
+		}
 		vector& operator=(const vector& other) {
-			vector temp(other.begin(), other.end());
-			this->swap(temp);
+			if (this == &other) { return *this; }
+			if constexpr (_Choose_pocca_v<_Alty>) {
+				if (_Get_alloc() != other._Get_alloc()) { _Tidy(); }
+			}
+			_Pocca(_Get_alloc(), other._Get_alloc());
+			vector temp(other, _Get_alloc());
+			swap_data(temp);
 			return *this;
 		}
-		vector(vector&& other) noexcept { exchange(other); }
-		vector& operator=(vector&& other) noexcept {
+		vector(vector&& other) noexcept
+			: m_pair_(_One_then_variadic_args_t{}, std::move(other._Get_alloc())) {
+			exchange(other);
+		}
+		vector(vector&& other, const allocator_type& alloc)
+			: m_pair_(_One_then_variadic_args_t{}, alloc) {
+			if constexpr (!_Alty_traits::is_always_equal::value) {
+				if (_Get_alloc() != other._Get_alloc()) { // 分配器不相等时不能接管对方的内存，逐个移动元素
+					const size_type num = other.size();
+					if (0 == num) { return; }
+					alloc_n(num);
+					try {
+						_Mylast() = _Uninitialized_move(other._Myfirst().raw_ptr(), other._Mylast().raw_ptr(),
+							_Myfirst().raw_ptr(), _Get_alloc());
+					}
+					catch (...) {
+						_Tidy();
+						throw;
+					}
+					return;
+				}
+			}
+			exchange(other);
+		}
+		vector& operator=(vector&& other)
+			noexcept(_Choose_pocma_v<_Alty> != _Pocma_values::_No_propagate_allocators) {
 			if (this == &other) return *this;
-			clear();
+			if constexpr (_Choose_pocma_v<_Alty> == _Pocma_values::_No_propagate_allocators) {
+				if (_Get_alloc() != other._Get_alloc()) {
+					vector temp(std::move(other), _Get_alloc());
+					swap_data(temp);
+					return *this;
+				}
+			}
+			_Tidy();
+			_Pocma(_Get_alloc(), other._Get_alloc());
 			exchange(other);
 			return *this;
 		}
 		vector& operator=(std::initializer_list<value_type> ilist) {
-			vector temp(ilist.begin(), ilist.end());
-			this->swap(temp);
+			vector temp(ilist.begin(), ilist.end(), _Get_alloc());
+			swap_data(temp);
 			return *this;
 		}
-		~vector() {
-			if (start_.raw_ptr() != nullptr) {
-				destroy(start_, finish_);
-				data_allocator::deallocate(start_.raw_ptr(),
-					(end_of_storage_ - start_) * sizeof(value_type));
-				start_ = finish_ = end_of_storage_ = nullptr;
-			}
-		}
+		~vector() { _Tidy(); }
 
 	public:
-		iterator begin() noexcept { return start_; }
-		iterator end() noexcept { return finish_; }
-		const_iterator begin() const noexcept { return start_; }
-		const_iterator end() const  noexcept { return finish_; }
-		const_iterator cbegin() const noexcept { return start_; }
-		const_iterator cend() const  noexcept { return finish_; }
+		iterator begin() noexcept { return _Make_iter(_Myfirst().raw_ptr()); }
+		iterator end() noexcept { return _Make_iter(_Mylast().raw_ptr()); }
+		const_iterator begin() const noexcept { return _Make_iter(_Myfirst().raw_ptr()); }
+		const_iterator end() const  noexcept { return _Make_iter(_Mylast().raw_ptr()); }
+		const_iterator cbegin() const noexcept { return _Make_iter(_Myfirst().raw_ptr()); }
+		const_iterator cend() const  noexcept { return _Make_iter(_Mylast().raw_ptr()); }
 		// rbegin rend
 		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
 		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
 		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
 		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
 
+		allocator_type get_allocator() const noexcept { return _Get_alloc(); }
+
 		reference at(size_type index) {
 			if (is_invalid_index(index)) {
 				throw std::out_of_range
 				{ "vector member func at() error: index out of range" };
 			}
-			return *(start_ + index);
+			return *(_Myfirst() + index);
 		}
 		const_reference at(size_type index) const {
 			if (is_invalid_index(index)) {
 				throw std::out_of_range
 				{ "vector member func at() error: index out of range" };
 			}
-			return *(start_ + index);
+			return *(_Myfirst() + index);
+		}
+		reference front() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "front() called on empty vector");
+			return *_Myfirst();
+		}
+		const_reference front() const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "front() called on empty vector");
+			return *_Myfirst();
 		}
-		reference front() { return *start_; }
-		const_reference front() const { return *start_; }
-		reference back() { return *(--finish_); }
-		const_reference back() const { return *(--finish_); }
-		size_type size() const noexcept { return size_type(finish_ - start_); }
-		size_type capacity() const noexcept { return size_type(end_of_storage_ - start_); }
-		bool empty() const noexcept { return start_ == finish_; }
+		reference back() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "back() called on empty vector");
+			return *(_Mylast() - 1);
+		}
+		const_reference back() const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "back() called on empty vector");
+			return *(_Mylast() - 1);
+		}
+		size_type size() const noexcept { return size_type(_Mylast() - _Myfirst()); }
+		size_type capacity() const noexcept { return size_type(_Myend() - _Myfirst()); }
+		size_type max_size() const noexcept { return _Alty_traits::max_size(_Get_alloc()); }
+
+		// 该 vector 类型所有对象的扩容统计，用于比较不同的扩容策略
+		static vector_growth_stats growth_stats() noexcept {
+			vector_growth_stats result{};
+			result.policy = Growth::name;
+			result.grows = stat_grows.get();
+			result.relocated = stat_relocated.get();
+			result.bytes = stat_bytes.get();
+			return result;
+		}
+		bool empty() const noexcept { return _Myfirst() == _Mylast(); }
 
 		template<typename IptIter, std::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
-		void assign(IptIter first, IptIter last) {  // std::vector  copy assignment operator
-			vector temp{ first, last };
-			this->swap(temp);
+		void assign(IptIter first, IptIter last) {
+			assign_iter(first, last);
 		}
 
 		void assign(std::initializer_list<value_type> ilist) {
@@ -395,8 +759,8 @@ namespace mstd {
 		}
 
 		void assign(size_type size, const value_type& value) {
-			vector temp = vector(size, value);
-			this->swap(temp);
+			vector temp(size, value, _Get_alloc());
+			swap_data(temp);
 		}
 
 		void push_back(const value_type& val) {
@@ -407,199 +771,223 @@ namespace mstd {
 			emplace_back(std::move(val));
 		}
 
-		void pop_back() noexcept {
-			destroy(&*--finish_);
+		void pop_back() noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(!empty(), "pop_back() called on empty vector");
+			_Alty_traits::destroy(_Get_alloc(), (--_Mylast()).raw_ptr());
 		}
 
 		template <typename... Args>
 		iterator emplace(const_iterator pos, Args&&... args) {
-			if (is_invalid_insert_iterator(pos)) {
-				throw std::out_of_range
-				{ "vector member func emplace() error: iterator out of range" };
-			}
-			difference_type index = std::distance(cbegin(), pos); //ʹindex¼ƫ
+			_MSTD_HARDENED_CHECK(!is_invalid_insert_iterator(pos),
+				"vector member func emplace() error: iterator out of range");
+			difference_type index = std::distance(cbegin(), pos); //使用index记录偏移量
 			check_and_alloc(1);
-			iterator new_iter{ start_ + index };  // check_and_alloc ԭʧЧ
+			iterator new_iter{ _Myfirst() + index };  // check_and_alloc后 原迭代器可能失效
 			move_backward_n(new_iter, 1);
-			construct(new_iter.raw_ptr(), std::forward<Args>(args)...);
-			return new_iter;
+			_Alty_traits::construct(_Get_alloc(), new_iter.raw_ptr(), std::forward<Args>(args)...);
+			return _Make_iter(new_iter.raw_ptr());
 		}
 
 		template <typename... Args>
 		void emplace_back(Args&&... args) {
-			emplace(finish_, std::forward<Args>(args)...);
+			emplace(_Mylast(), std::forward<Args>(args)...);
 		}
 
 		iterator erase(const_iterator pos) {
-			if (is_invalid_iterator(pos)) {
-				throw std::out_of_range
-				{ "vector member func erase() error: iterator out of range" };
-			}
+			_MSTD_HARDENED_CHECK(!is_invalid_iterator(pos),
+				"vector member func erase() error: iterator out of range");
 			move_forward_n(pos + 1, 1);
-			return pos;
+			return _Make_iter(pos.raw_ptr());
 		}
 
 		iterator erase(const_iterator first, const_iterator last) {
-			if (is_invalid_iterator(first) || is_invalid_iterator(last)) {
-				throw std::out_of_range
-				{ "vector member func erase() error: iterator out of range" };
-			}
+			_MSTD_HARDENED_CHECK(!(is_invalid_insert_iterator(first) || is_invalid_insert_iterator(last) || last < first),
+				"vector member func erase() error: iterator out of range");
 			move_forward_n(last, static_cast<size_type>(last - first));
-			return first;
+			return _Make_iter(first.raw_ptr());
 		}
 
 		iterator insert(const_iterator pos, const value_type& val) {
-			if (is_invalid_insert_iterator(pos)) {
-				throw std::out_of_range
-				{ "vector member func insert() error: iterator out of range" };
-			}
+			_MSTD_HARDENED_CHECK(!is_invalid_insert_iterator(pos),
+				"vector member func insert() error: iterator out of range");
 			difference_type index = std::distance(cbegin(), pos);
 			check_and_alloc(1);
-			iterator new_iter{ start_ + index };
+			iterator new_iter{ _Myfirst() + index };
 			move_backward_n(new_iter, 1);
-			construct(new_iter.raw_ptr(), val);
-			return new_iter;
+			_Alty_traits::construct(_Get_alloc(), new_iter.raw_ptr(), val);
+			return _Make_iter(new_iter.raw_ptr());
 		}
 
 		iterator insert(const_iterator pos, value_type&& val) {
-			if (is_invalid_insert_iterator(pos)) {
-				throw std::out_of_range
-				{ "vector member func insert() error: iterator out of range" };
-			}
+			_MSTD_HARDENED_CHECK(!is_invalid_insert_iterator(pos),
+				"vector member func insert() error: iterator out of range");
 			difference_type index = std::distance(cbegin(), pos);
 			check_and_alloc(1);
-			iterator new_iter{ start_ + index };
+			iterator new_iter{ _Myfirst() + index };
 			move_backward_n(new_iter, 1);
-			construct(new_iter.raw_ptr(), std::move(val));
-			return new_iter;
+			_Alty_traits::construct(_Get_alloc(), new_iter.raw_ptr(), std::move(val));
+			return _Make_iter(new_iter.raw_ptr());
 		}
 
 		iterator insert(const_iterator pos, size_type num, const value_type& value) {
-			if (is_invalid_insert_iterator(pos)) {
-				throw std::out_of_range
-				{ "vector member func insert() error: iterator out of range" };
-			}
+			_MSTD_HARDENED_CHECK(!is_invalid_insert_iterator(pos),
+				"vector member func insert() error: iterator out of range");
 			difference_type index = std::distance(cbegin(), pos);
 			check_and_alloc(num);
-			iterator new_iter{ start_ + index };
+			iterator new_iter{ _Myfirst() + index };
 			move_backward_n(new_iter, num);
 			iterator iter{ new_iter };
 			iterator last{ new_iter + num };
 			for (; iter != last; ++iter) {
-				construct(iter.raw_ptr(), value);
+				_Alty_traits::construct(_Get_alloc(), iter.raw_ptr(), value);
 			}
-			return new_iter;
+			return _Make_iter(new_iter.raw_ptr());
 		}
 
 		template<typename IptIter, std::enable_if_t<mstd::_Is_iterator_v<IptIter>, int> = 0>
 		iterator insert(const_iterator pos, IptIter first, IptIter last) {
-			if (is_invalid_insert_iterator(pos)) {
-				throw std::out_of_range
-				{ "vector member func insert() error: iterator out of range" };
-			}
-			difference_type num = std::distance(first, last);
-			difference_type index = std::distance(cbegin(), pos);
-			check_and_alloc(num);
-			iterator new_iter{ start_ + index };
-			move_backward_n(new_iter, num);
-			iterator iter{ new_iter };
-			for (; first != last; ++first, ++iter) {
-				construct(iter.raw_ptr(), *first);
-			}
-			return new_iter;
+			return insert_iter(pos, first, last);
 		}
 
 		iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
 			return insert(pos, ilist.begin(), ilist.end());
 		}
 
-		Tp* data() noexcept { return start_.raw_ptr(); }
+		// 接受任何提供 begin()/end() 的区间，长度已知时只分配一次
+		template<typename Range>
+		void append_range(Range&& rg) {
+			using std::begin;
+			using std::end;
+			append_iter(begin(rg), end(rg));
+		}
+
+		template<typename Range>
+		iterator insert_range(const_iterator pos, Range&& rg) {
+			using std::begin;
+			using std::end;
+			return insert_iter(pos, begin(rg), end(rg));
+		}
+
+		template<typename Range>
+		void assign_range(Range&& rg) {
+			using std::begin;
+			using std::end;
+			assign_iter(begin(rg), end(rg));
+		}
+
+		Tp* data() noexcept { return _Myfirst().raw_ptr(); }
 
-		const Tp* data() const noexcept { return start_.raw_ptr(); }
+		const Tp* data() const noexcept { return _Myfirst().raw_ptr(); }
 
 		void resize(size_type new_sz) {
-			resize(new_sz, value_type{});
+			if (new_sz > size()) {
+				if (new_sz > capacity()) {
+					check_and_alloc(new_sz - size());
+				}
+				_Mylast() = _Uninitialized_value_construct_n(_Mylast().raw_ptr(), new_sz - size(), _Get_alloc());
+			}
+			else {
+				_Destroy_range((_Myfirst() + new_sz).raw_ptr(), _Mylast().raw_ptr(), _Get_alloc());
+				_Mylast() = _Myfirst() + new_sz;
+			}
+		}
+
+		// 新增的元素只做默认初始化，平凡类型不清零，由调用者随后写入(例如 read()、解码器)
+		void resize_default_init(size_type new_sz) {
+			if (new_sz > size()) {
+				uninitialized_append(new_sz - size());
+			}
+			else {
+				resize(new_sz);
+			}
+		}
+
+		void resize_for_overwrite(size_type new_sz) {
+			resize_default_init(new_sz);
+		}
+
+		// 在末尾追加n个默认初始化的元素，返回第一个新元素的地址
+		pointer uninitialized_append(size_type n) {
+			check_and_alloc(n);
+			pointer result = _Mylast().raw_ptr();
+			_Mylast() = _Uninitialized_default_construct_n(result, n, _Get_alloc());
+			return result;
 		}
 
 		void resize(size_type new_sz, const value_type& value) {
 			if (new_sz > size()) {
 				if (new_sz > capacity()) {
-					check_and_alloc(new_sz);
+					check_and_alloc(new_sz - size());
 				}
-				finish_ = uninitialized_fill_n(finish_, new_sz - size(), value);
+				_Mylast() = _Uninitialized_fill_n(_Mylast().raw_ptr(), new_sz - size(), value, _Get_alloc());
 			}
 			else {
-				destroy(start_ + new_sz, finish_);
-				finish_ = start_ + new_sz;
+				_Destroy_range((_Myfirst() + new_sz).raw_ptr(), _Mylast().raw_ptr(), _Get_alloc());
+				_Mylast() = _Myfirst() + new_sz;
 			}
 		}
 
 		void reserve(size_type new_capacity) {
 			if (new_capacity > capacity()) {
-				vector temp{};
-				this->swap(temp);
-				alloc_n(new_capacity);
-				iterator iter{ temp.begin() }, dest{ start_ };
-				for (; iter != temp.end(); ++iter, ++dest) {
-					construct(dest.raw_ptr(), std::move(*iter));
-				}
-				finish_ = dest;
+				reallocate_n(new_capacity);
 			}
 		}
 
 		void clear() noexcept {
-			destroy(start_, finish_);
-			finish_ = start_;
+			_Get_data()._Orphan_all();
+			_Destroy_range(_Myfirst().raw_ptr(), _Mylast().raw_ptr(), _Get_alloc());
+			_Mylast() = _Myfirst();
 		}
 
 		void shrink_to_fit() {
 			if (size() != capacity()) {
-				if (start_ == finish_) {
-					data_allocator::deallocate(&start_, size() * sizeof(value_type));
-					start_ = finish_ = end_of_storage_ = nullptr;
+				if (empty()) {
+					_Tidy();
 				}
 				else {
-					auto num{ size() };
-					vector temp = std::move(*this);
-					alloc_n(num);
-					finish_ = uninitialized_move(temp.begin(), temp.end(), start_);
+					reallocate_n(size());
 				}
 			}
 		}
 
-		reference operator[](size_type index) {
-			if (is_invalid_index(index)) {
-				throw std::out_of_range
-				{ "vector member func operator[]() error: index out of range" };
-			}
-			return *(start_ + index);
+		reference operator[](size_type index) noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(index < size(), "vector subscript out of range");
+			return _Myfirst().raw_ptr()[index];
 		}
 
-		const_reference operator[](size_type index) const {
-			if (is_invalid_index(index)) {
-				throw std::out_of_range
-				{ "vector member func operator[]() error: index out of range" };
-			}
-			return *(start_ + index);
+		const_reference operator[](size_type index) const noexcept(_MSTD_HARDENING_MODE != 2) {
+			_MSTD_HARDENED_CHECK(index < size(), "vector subscript out of range");
+			return _Myfirst().raw_ptr()[index];
 		}
 
+		// propagate_on_container_swap 为 false 时只交换元素，分配器不相等时行为未定义
 		void swap(vector& right) noexcept {
-			mstd::swap(start_, right.start_);
-			mstd::swap(finish_, right.finish_);
-			mstd::swap(end_of_storage_, right.end_of_storage_);
+			if (this != &right) {
+				_Pocs(_Get_alloc(), right._Get_alloc());
+				swap_data(right);
+			}
 		}
 
 	};
 
-	template<typename Tp, typename Alloc>
-	inline void swap(const vector<Tp, Alloc>& left,
-		const vector<Tp, Alloc>& right) noexcept {
+	template<typename Tp, typename Alloc, typename Growth>
+	_Stat_counter vector<Tp, Alloc, Growth>::stat_grows{};
+
+	template<typename Tp, typename Alloc, typename Growth>
+	_Stat_counter vector<Tp, Alloc, Growth>::stat_relocated{};
+
+	template<typename Tp, typename Alloc, typename Growth>
+	_Stat_counter vector<Tp, Alloc, Growth>::stat_bytes{};
+
+	template<typename Tp, typename Alloc, typename Growth>
+	inline void swap(vector<Tp, Alloc, Growth>& left,
+		vector<Tp, Alloc, Growth>& right) noexcept {
 		left.swap(right);
 	}
 
-	template<typename Tp, typename Alloc>
-	inline bool operator>(const vector<Tp, Alloc>& left,
-		const vector<Tp, Alloc>& right) noexcept {
+	template<typename Tp, typename Alloc, typename Growth>
+	inline bool operator>(const vector<Tp, Alloc, Growth>& left,
+		const vector<Tp, Alloc, Growth>& right) noexcept {
 		auto lhs_begin{ left.begin() };
 		auto lhs_end{ left.end() };
 		auto rhs_begin{ right.begin() };
@@ -611,9 +999,9 @@ namespace mstd {
 		return true;
 	}
 
-	template<typename Tp, typename Alloc>
-	inline bool operator<(const vector<Tp, Alloc>& left,
-		const vector<Tp, Alloc>& right) noexcept {
+	template<typename Tp, typename Alloc, typename Growth>
+	inline bool operator<(const vector<Tp, Alloc, Growth>& left,
+		const vector<Tp, Alloc, Growth>& right) noexcept {
 		auto lhs_begin{ left.begin() };
 		auto lhs_end{ left.end() };
 		auto rhs_begin{ right.begin() };
@@ -625,21 +1013,21 @@ namespace mstd {
 		return true;
 	}
 
-	template<typename Tp, typename Alloc>
-	inline bool operator>=(const vector<Tp, Alloc>& left,
-		const vector<Tp, Alloc>& right) noexcept {
+	template<typename Tp, typename Alloc, typename Growth>
+	inline bool operator>=(const vector<Tp, Alloc, Growth>& left,
+		const vector<Tp, Alloc, Growth>& right) noexcept {
 		return !(left < right);
 	}
 
-	template<typename Tp, typename Alloc>
-	inline bool operator<=(const vector<Tp, Alloc>& left,
-		const vector<Tp, Alloc>& right) noexcept {
+	template<typename Tp, typename Alloc, typename Growth>
+	inline bool operator<=(const vector<Tp, Alloc, Growth>& left,
+		const vector<Tp, Alloc, Growth>& right) noexcept {
 		return !(left > right);
 	}
 
-	template<typename Tp, typename Alloc>
-	inline bool operator==(const vector<Tp, Alloc>& left,
-		const vector<Tp, Alloc>& right) noexcept {
+	template<typename Tp, typename Alloc, typename Growth>
+	inline bool operator==(const vector<Tp, Alloc, Growth>& left,
+		const vector<Tp, Alloc, Growth>& right) noexcept {
 		if (left.size() != right.size()) return false;
 		for (auto iter{ right.begin() }; iter != right.end(); ++iter) {
 			if (*iter != right.at(static_cast<size_t>(iter - left.begin())))
@@ -648,11 +1036,21 @@ namespace mstd {
 		return true;
 	}
 
-	template<typename Tp, typename Alloc>
-	inline bool operator!=(const vector<Tp, Alloc>& left,
-		const vector<Tp, Alloc>& right) noexcept {
+	template<typename Tp, typename Alloc, typename Growth>
+	inline bool operator!=(const vector<Tp, Alloc, Growth>& left,
+		const vector<Tp, Alloc, Growth>& right) noexcept {
 		return !(left == right);
 	}
 
+	// vector 只保存指向堆内存的指针和分配器，分配器可以按字节搬移时 vector 也可以
+	template<typename Tp, typename Alloc, typename Growth>
+	struct is_trivially_relocatable<vector<Tp, Alloc, Growth>>
+		: _Container_is_trivially_relocatable<_Container_alloc_t<Alloc, Tp>> {};
+
+	namespace pmr {
+		template<class Tp>
+		using vector = mstd::vector<Tp, polymorphic_allocator<Tp>>;
+	}
+
 }
 
@@ -191,6 +191,35 @@ void test_vector() {
 #undef stl
 }
 
+#include <chrono>
+#include <cstdlib>	// std::rand();
+
+// 比较不同扩容策略：扩容次数、搬移的元素个数、最终的空闲容量和耗时
+// 扩容计数需要定义 _MSTD_ALLOC_STATS 为1
+template<typename Growth>
+void bench_vector_growth(size_t n) {
+	using vec = mstd::vector<int, mstd::malloc_allocator<0>, Growth>;
+	auto start = std::chrono::steady_clock::now();
+	vec v;
+	for (size_t i = 0; i < n; ++i) {
+		v.push_back(static_cast<int>(i));
+	}
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start).count();
+	auto stats = vec::growth_stats();
+	cout << stats.policy << ": grows " << stats.grows << " relocated " << stats.relocated
+		<< " slack " << (v.capacity() - v.size()) * sizeof(int) << " bytes "
+		<< elapsed << " us" << endl;
+}
+
+void bench_vector_growths() {
+	const size_t n = 1000000;
+	bench_vector_growth<mstd::vector_growth_2x>(n);
+	bench_vector_growth<mstd::vector_growth_1_5x>(n);
+	bench_vector_growth<mstd::vector_growth_page<>>(n);
+	bench_vector_growth<mstd::vector_growth_usable_size>(n);
+}
+
 #include "m_list.h"
 
 void test_list() {
@@ -255,13 +284,357 @@ void test_list() {
 	print_container(mstr5);
 	mstr5.sort();
 	mstr4.sort();
-	mstr5.merge(mstr4);  // Ҫsort();
+	mstr5.merge(mstr4);  // 需要先sort();
 	print_container(mstr5);
 	cout << mstr5.size() << endl;
 	cout << (mstr5 < mstr4) << endl;
 #undef stl
 }
 
+#include "m_deque.h"
+
+// int 的块大小为1024，几千个元素即可跨越多个块并触发 map 扩容；结果与 std::deque 对照
+void test_deque() {
+#define stl mstd
+	stl::deque<Str> dstr{ "bb","cc" };
+	dstr.push_front("aa");
+	dstr.emplace_back("dd");
+	print_container(dstr);
+	dstr.insert(dstr.begin() + 2, "xx");
+	print_container(dstr);
+	dstr.erase(dstr.begin() + 1);
+	print_container(dstr);
+	dstr.pop_front();
+	dstr.pop_back();
+	print_container(dstr);
+
+	stl::deque<int> di;
+	std::deque<int> ref;
+	// 两端交替压入，跨越块边界并多次扩容 map
+	for (int i = 0; i < 5000; ++i) {
+		if (i % 3 == 0) { di.push_front(i); ref.push_front(i); }
+		else { di.push_back(i); ref.push_back(i); }
+	}
+	assert(di.size() == ref.size() && std::equal(di.begin(), di.end(), ref.begin()));
+	// 两端弹出使首元素偏移越过块边界后再压入
+	for (int i = 0; i < 1500; ++i) {
+		di.pop_front(); ref.pop_front();
+		di.pop_back(); ref.pop_back();
+	}
+	for (int i = 0; i < 3000; ++i) {
+		di.push_back(-i); ref.push_back(-i);
+	}
+	assert(std::equal(di.begin(), di.end(), ref.begin(), ref.end()));
+
+	// 中间插入/删除，分别从较短的一端搬移元素
+	di.insert(di.begin() + 10, 2000, 7);
+	ref.insert(ref.begin() + 10, 2000, 7);
+	di.insert(di.end() - 10, { 1,2,3 });
+	ref.insert(ref.end() - 10, { 1,2,3 });
+	di.erase(di.begin() + 100, di.begin() + 1600);
+	ref.erase(ref.begin() + 100, ref.begin() + 1600);
+	di.erase(di.end() - 50);
+	ref.erase(ref.end() - 50);
+	assert(std::equal(di.begin(), di.end(), ref.begin(), ref.end()));
+
+	// 跨块的迭代器运算
+	auto first = di.begin();
+	auto last = di.end();
+	assert(last - first == static_cast<ptrdiff_t>(di.size()));
+	auto mid = first + 2500;
+	assert(*mid == ref[2500] && mid[-1300] == ref[1200] && *(mid - 2000) == ref[500]);
+	mid -= 2500;
+	assert(mid == first);
+	mid += static_cast<ptrdiff_t>(di.size());
+	assert(mid == last && first < last);
+	assert(*(di.rbegin() + 1024) == ref[ref.size() - 1025]);
+
+	di.resize(10);
+	ref.resize(10);
+	di.shrink_to_fit();
+	print_container(di);
+	assert(std::equal(di.begin(), di.end(), ref.begin(), ref.end()));
+	cout << di.size() << " " << di.front() << " " << di.back() << endl;
+#undef stl
+}
+
+#include "m_small_vector.h"
+
+// 内部缓冲区与堆内存之间的转换：移动、swap、shrink_to_fit
+void test_small_vector() {
+#define stl mstd
+	stl::small_vector<Str, 2> sstr{ "a","b" };
+	stl::small_vector<Str, 2> sstr2(std::move(sstr));	// 内部缓冲区中的元素逐个搬移
+	print_container(sstr2);
+	sstr2.push_back("c");								// 超出N，转移到堆上
+	print_container(sstr2);
+
+	using svec = stl::small_vector<std::string, 4>;
+	svec inl{ "1","2" };
+	svec heap{ "a","b","c","d","e","f" };
+	assert(inl.is_inline() && !heap.is_inline());
+
+	// 移动：内部缓冲区逐个搬移，堆内存直接接管
+	svec moved_inl(std::move(inl));
+	assert(moved_inl.is_inline() && moved_inl.size() == 2 && inl.empty() && inl.is_inline());
+	const std::string* heap_data = heap.data();
+	svec moved_heap(std::move(heap));
+	assert(!moved_heap.is_inline() && moved_heap.data() == heap_data && heap.empty() && heap.is_inline());
+	inl = std::move(moved_heap);
+	assert(!inl.is_inline() && inl.data() == heap_data && moved_heap.is_inline());
+	moved_heap = std::move(moved_inl);
+	assert(moved_heap.is_inline() && moved_heap.size() == 2 && moved_heap[1] == "2");
+
+	// swap：内部/内部、内部/堆、堆/堆
+	svec a{ "x" };
+	svec b{ "y","z" };
+	a.swap(b);
+	assert(a.is_inline() && b.is_inline() && a.size() == 2 && b[0] == "x");
+	a.swap(inl);
+	assert(!a.is_inline() && a.data() == heap_data && a.size() == 6 && inl.is_inline() && inl[1] == "z");
+	svec c(10, "h");
+	c.swap(a);
+	assert(!a.is_inline() && !c.is_inline() && c.data() == heap_data && a.size() == 10);
+	print_container(c);
+
+	// shrink_to_fit：不超过N时搬回内部缓冲区，否则按元素个数重新分配
+	c.resize(3);
+	c.shrink_to_fit();
+	assert(c.is_inline() && c.capacity() == svec::inline_capacity && c[2] == "c");
+	a.resize(5);
+	a.shrink_to_fit();
+	assert(!a.is_inline() && a.capacity() == 5 && a[4] == "h");
+	print_container(c);
+	print_container(a);
+#undef stl
+}
+
+#include "m_static_vector.h"
+
+#if __cpp_constexpr >= 201907L	// C++20 起 constexpr 函数中允许不初始化的数组成员
+// 平凡类型的 static_vector 可以在常量表达式中使用
+constexpr int static_vector_sum() {
+	mstd::static_vector<int, 8> sv{ 1,2,3 };
+	sv.push_back(4);
+	sv.insert(sv.begin(), 0);
+	sv.erase(sv.begin() + 1);
+	int sum = 0;
+	for (int x : sv) { sum += x; }
+	return sum;
+}
+static_assert(static_vector_sum() == 9, "static_vector constexpr");
+#endif
+
+// 超出容量时 push_back 抛出 std::bad_alloc，try_push_back 返回 nullptr
+void test_static_vector() {
+#define stl mstd
+	stl::static_vector<Str, 4> sstr{ "a","b" };
+	sstr.emplace_back("c");
+	sstr.insert(sstr.begin(), "0");
+	print_container(sstr);
+	assert(sstr.full() && sstr.try_push_back("d") == nullptr);
+	try {
+		sstr.push_back("e");
+	}
+	catch (const std::bad_alloc& e) {
+		cout << e.what() << endl;
+	}
+	stl::static_vector<Str, 4> sstr2(sstr);
+	sstr2.erase(sstr2.begin() + 1, sstr2.end() - 1);
+	print_container(sstr2);
+	sstr = std::move(sstr2);
+	print_container(sstr);
+	sstr.resize(3);
+	sstr.pop_back();
+	print_container(sstr);
+	cout << sstr.size() << " " << sstr.capacity() << endl;
+#undef stl
+}
+
+#include "m_mpsc_queue.h"
+
+// 多个生产者并发 push，消费者用 consume_all 一次取走当前全部元素；每个生产者的元素保持入队顺序
+void test_mpsc_queue() {
+	const int producers = 4;
+	const int per_producer = 100000;
+	mstd::mpsc_queue<std::pair<int, int>> que;
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p) {
+		threads.emplace_back([&que, p] {
+			for (int i = 0; i < per_producer; ++i) {
+				que.push({ p, i });
+			}
+		});
+	}
+
+	std::vector<int> next(producers, 0);
+	long long total = 0;
+	size_t batches = 0;
+	while (total < static_cast<long long>(producers) * per_producer) {
+		const size_t count = que.consume_all([&next](std::pair<int, int>& item) {
+			assert(item.second == next[item.first]);
+			++next[item.first];
+		});
+		if (0 == count) {
+			std::this_thread::yield();
+			continue;
+		}
+		total += count;
+		++batches;
+	}
+	for (auto& t : threads) { t.join(); }
+	assert(que.empty());
+
+	mstd::mpsc_queue<Str> sque;
+	sque.emplace("first");
+	sque.push(Str{ "second" });
+	Str out;
+	sque.try_pop(out);
+	cout << out << endl;
+	sque.consume_all([](Str& item) { cout << item << endl; });
+	cout << total << " elements in " << batches << " batches" << endl;
+}
+
+#include "m_ring_buffer.h"
+#include <atomic>
+
+// spsc_ring: 一个生产者、一个消费者按序传递序号，批量读写跨过环尾回绕
+// mpmc_ring: 容量向上取整为 2 的幂；多生产者多消费者时每个生产者的序号保持入队顺序，总数和总和不变
+void test_ring_buffers() {
+	{
+		mstd::spsc_ring<int, 8> ring;
+		int in[6] = { 0, 1, 2, 3, 4, 5 };
+		int out[8] = {};
+		assert(6 == ring.push_batch(in, 6));
+		assert(6 == ring.pop_batch(out, 8));
+		// 此时头尾都在下标 6，下面的 push_batch/pop_batch 跨过环尾
+		int wrap[8] = { 10, 11, 12, 13, 14, 15, 16, 17 };
+		assert(8 == ring.push_batch(wrap, 8));
+		assert(!ring.try_push(18));
+		assert(8 == ring.size());
+		assert(5 == ring.pop_batch(out, 5));
+		assert(3 == ring.pop_batch(out + 5, 8));
+		for (int i = 0; i < 8; ++i) { assert(out[i] == wrap[i]); }
+		assert(ring.empty());
+	}
+
+	const int count = 1000000;
+	{
+		mstd::spsc_ring<int, 1024> ring;
+		std::thread producer([&ring] {
+			int buf[16];
+			for (int i = 0; i < count;) {
+				int n = 0;
+				for (; n < 16 && i + n < count; ++n) { buf[n] = i + n; }
+				// 单个 push 与批量 push 交替使用
+				const size_t pushed = (i & 1) ? ring.push_batch(buf, n) : ring.try_push(buf[0]);
+				if (0 == pushed) { std::this_thread::yield(); }
+				i += static_cast<int>(pushed);
+			}
+		});
+		int next = 0;
+		int buf[32];
+		while (next < count) {
+			const size_t popped = ring.pop_batch(buf, 32);
+			if (0 == popped) {
+				std::this_thread::yield();
+				continue;
+			}
+			for (size_t i = 0; i != popped; ++i) { assert(buf[i] == next++); }
+		}
+		producer.join();
+		assert(ring.empty());
+	}
+
+	{
+		mstd::mpmc_ring<Str> ring(5);
+		assert(8 == ring.capacity());
+		for (int i = 0; i < 8; ++i) { assert(ring.try_push(Str{ "str" })); }
+		assert(!ring.try_push(Str{ "full" }));
+		Str out;
+		assert(ring.try_pop(out));
+		cout << out << endl;
+		// 剩余元素由析构函数销毁
+	}
+
+	{
+		const int producers = 4;
+		const int consumers = 4;
+		const int per_producer = 200000;
+		mstd::mpmc_ring<std::pair<int, int>> ring(100);
+		assert(128 == ring.capacity());
+		std::atomic<long long> total{ 0 };
+		std::atomic<long long> sum{ 0 };
+		std::vector<std::thread> threads;
+		for (int p = 0; p < producers; ++p) {
+			threads.emplace_back([&ring, p] {
+				for (int i = 0; i < per_producer;) {
+					if (ring.try_push({ p, i })) { ++i; }
+					else { std::this_thread::yield(); }
+				}
+			});
+		}
+		for (int c = 0; c < consumers; ++c) {
+			threads.emplace_back([&] {
+				// 同一消费者看到的同一生产者的序号必须递增
+				std::vector<int> last(producers, -1);
+				std::pair<int, int> buf[8];
+				while (total.load(std::memory_order_relaxed) < static_cast<long long>(producers) * per_producer) {
+					const size_t popped = ring.pop_batch(buf, 8);
+					if (0 == popped) {
+						std::this_thread::yield();
+						continue;
+					}
+					long long local = 0;
+					for (size_t i = 0; i != popped; ++i) {
+						assert(buf[i].second > last[buf[i].first]);
+						last[buf[i].first] = buf[i].second;
+						local += buf[i].second;
+					}
+					sum += local;
+					total += static_cast<long long>(popped);
+				}
+			});
+		}
+		for (auto& t : threads) { t.join(); }
+		assert(ring.empty());
+		assert(total == static_cast<long long>(producers) * per_producer);
+		assert(sum == static_cast<long long>(producers) * per_producer * (per_producer - 1) / 2);
+	}
+	cout << "ring buffers ok" << endl;
+}
+
+// 比较 list::sort 的两种方式：节点上的自底向上归并与复制到缓冲区排序后重新链接
+// 先按随机值排序一次，使节点在内存中的顺序与链表顺序无关
+struct list_sort_probe : mstd::list<int> {
+	void by_merge() { _Node::sort_by_merge(_Myhead(), std::less<>{}); }
+	void by_copy() { _Node::sort_by_copy(_Get_alloc(), _Myhead(), size(), std::less<>{}); }
+};
+
+void bench_list_sort(size_t n, bool copy) {
+	list_sort_probe lst;
+	for (size_t i = 0; i < n; ++i) {
+		lst.push_back(std::rand());
+	}
+	lst.by_merge();
+	const size_t reps = 4000000 / n + 1;
+	long long elapsed = 0;
+	for (size_t r = 0; r < reps; ++r) {
+		for (auto& x : lst) { x = std::rand(); }
+		auto start = std::chrono::steady_clock::now();
+		copy ? lst.by_copy() : lst.by_merge();
+		elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - start).count();
+	}
+	cout << n << (copy ? " copy: " : " merge: ") << elapsed / reps / 1000.0 << " us" << endl;
+}
+
+void bench_list_sorts() {
+	for (size_t n = 4; n <= (1 << 20); n *= 4) {
+		bench_list_sort(n, false);
+		bench_list_sort(n, true);
+	}
+}
 
 void test_alignof() {
 	cout << alignof(std::max_align_t) << endl;
@@ -317,7 +690,7 @@ void test_alignof() {
 
 	// alignof
 	cout << "-------------------alignof---------------------" << endl;
-	// ֵ
+	// 基本对齐值
 	cout << "alignof(std::max_align_t)	" << alignof(std::max_align_t) << endl;
 	cout << endl;
 	cout << "-------basic type" << endl;
@@ -435,6 +808,8 @@ struct test_type<Tp&> {
 
 int main() {
 	//test_vector();
+	//bench_vector_growths();
+	//bench_list_sorts();
 	//mstd::vector<MString>::iterator it;
 	//cout << std::is_same_v<MString, std::remove_reference_t<decltype(*it)>> << endl;
 	//cout << std::is_same_v<std::true_type, std::is_trivially_destructible<decltype(*it)>::type> << endl;
@@ -462,6 +837,16 @@ int main() {
 
 	//test_list();
 
+	//test_deque();
+
+	//test_small_vector();
+
+	//test_static_vector();
+
+	//test_mpsc_queue();
+
+	//test_ring_buffers();
+
 	//int* ptr = new int{};
 	//cout << ptr << endl;
 	//cout << &(ptr[-1]) << endl;